@@ -0,0 +1,346 @@
+/**
+ * @brief Benchmark suite for the Array operators
+ *
+ * Sweeps every Array<T> operator over float, int32, int16 (Q8) and int8
+ * arrays, for lengths that fill whole vectors and lengths that leave a tail,
+ * and writes a JSON report (see esp_benchmark.h).
+ *
+ * Usage: espmath_benchmark [-o report.json] [-n samples]
+ */
+
+#include "esp_math.h"
+#include "esp_benchmark.h"
+
+#include <string.h>
+
+using namespace espmath;
+
+static const size_t lengths[] = {16, 19, 64, 67, 256, 259, 1024, 1027, 4096, 4099};
+static const size_t matrixSizes[] = {4, 8, 16, 19, 32, 64};
+static const size_t fftSizes[] = {64, 256, 1024, 4096};
+static const size_t parallelLengths[] = {4096, 16384, 65536};
+
+template<typename T>
+inline size_t maxRandom(){return 100;}
+
+template<>
+inline size_t maxRandom<int8_t>(){return 10;}
+
+template<typename T>
+inline void randomize(Array<T>& array)
+{
+  for (size_t i = 0; i < array.shape.size; i++)
+    array.flatten[i] = nonZeroRandomNumber<T>(maxRandom<T>());
+}
+
+/**
+ * @brief Operators shared by every type
+ *
+ * @tparam T Array type
+ * @param bench Benchmark
+ * @param length Array length
+ */
+template<typename T>
+void sweep(Benchmark& bench, const size_t length)
+{
+  Array<T> a(FRACTIONAL, shape2D(1, length));
+  Array<T> b(FRACTIONAL, shape2D(1, length));
+  Array<T> result;
+  ArrayMask mask;
+  ArrayStats<T> stats;
+  volatile T scalar;
+  randomize(a);
+  randomize(b);
+  const T c = nonZeroRandomNumber<T>(maxRandom<T>());
+
+  const size_t unary = 2*length*sizeof(T);
+  const size_t binary = 3*length*sizeof(T);
+
+  bench.run<T>("add", length, binary, [&]{result = a + b;});
+  bench.run<T>("sub", length, binary, [&]{result = a - b;});
+  bench.run<T>("mul", length, binary, [&]{result = a * b;});
+  bench.run<T>("div", length, binary, [&]{result = a / b;});
+  bench.run<T>("addc", length, unary, [&]{result = a + c;});
+  bench.run<T>("subc", length, unary, [&]{result = a - c;});
+  bench.run<T>("csub", length, unary, [&]{result = c - a;});
+  bench.run<T>("mulc", length, unary, [&]{result = a * c;});
+  bench.run<T>("divc", length, unary, [&]{result = a / c;});
+  bench.run<T>("cdiv", length, unary, [&]{result = c / a;});
+  bench.run<T>("mul_add", length, 4*length*sizeof(T), [&]{result = a*b + a;});
+  bench.run<T>("add_assign", length, binary, [&]{result += b;});
+  bench.run<T>("addc_assign", length, unary, [&]{result += c;});
+  bench.run<T>("dot", length, 2*length*sizeof(T), [&]{scalar = a ^ b;});
+  bench.run<T>("cmp_gt", length, length*sizeof(T) + (length + 7)/8, [&]{mask = a > c;});
+  mask = a > c;
+  bench.run<T>("compress", length, (length + mask.count())*sizeof(T) + (length + 7)/8, [&]{result = a[mask];});
+  bench.run<T>("where", length, binary + (length + 7)/8, [&]{result = where(mask, a, b);});
+  bench.run<T>("max", length, length*sizeof(T), [&]{scalar = a.max();});
+  bench.run<T>("stats", length, length*sizeof(T), [&]{stats = a.stats();});
+  (void)scalar;
+  (void)stats;
+}
+
+/**
+ * @brief Convolution, correlation, streaming FIR and IIR, available for float and int16_t arrays
+ *
+ * @tparam T Array type
+ * @param bench Benchmark
+ * @param length Array length
+ */
+template<typename T>
+void sweepConv(Benchmark& bench, const size_t length)
+{
+  const size_t kernelLength = 16;
+  Array<T> signal(FRACTIONAL, shape2D(1, length));
+  Array<T> kernel(FRACTIONAL, shape2D(1, kernelLength));
+  Array<T> result;
+  randomize(signal);
+  randomize(kernel);
+
+  const size_t convLength = length + kernelLength - 1;
+  bench.run<T>("conv", length, (length + kernelLength + convLength)*sizeof(T),\
+               [&]{result = signal.conv(kernel);});
+  bench.run<T>("correlation", length, (2*length + kernelLength)*sizeof(T),\
+               [&]{result = signal.correlation(kernel);});
+
+  Fir<T> fir(kernel, 1, length);
+  Array<T> block(FRACTIONAL, shape2D(1, length));
+  bench.run<T>("fir", length, (2*length + kernelLength)*sizeof(T),\
+               [&]{fir.process(signal, block, length);});
+
+  Array<T> sections(FRACTIONAL, shape2D(2, 5));
+  randomize(sections);
+  Iir<T> iir(sections);
+  bench.run<T>("iir", length, 2*length*sizeof(T), [&]{iir.process(signal, block, length);});
+}
+
+/**
+ * @brief Product of square matrices. The length reported is the matrix size.
+ *
+ * @tparam T Array type
+ * @param bench Benchmark
+ * @param size Rows (and columns) of the matrices
+ */
+template<typename T>
+void sweepMatrix(Benchmark& bench, const size_t size)
+{
+  Array<T> a(FRACTIONAL, shape2D(size, size));
+  Array<T> b(FRACTIONAL, shape2D(size, size));
+  Array<T> result;
+  randomize(a);
+  randomize(b);
+
+  bench.run<T>("matmul", size, 3*size*size*sizeof(T), [&]{result = a.matmul(b);});
+}
+
+/**
+ * @brief Complex and real FFTs, in place. Every run transforms a fresh copy
+ * of the signal, the copy is part of the measure.
+ *
+ * @tparam T Array type
+ * @param bench Benchmark
+ * @param n Number of points
+ */
+template<typename T>
+void sweepFft(Benchmark& bench, const size_t n)
+{
+  Array<T> signal(FRACTIONAL, shape2D(1, 2*n));
+  Array<T> spectrum(FRACTIONAL, shape2D(1, 2*n));
+  randomize(signal);
+  const Fft<T> fft(n);
+  const Rfft<T> rfft(n);
+
+  bench.run<T>("fft", n, 4*n*sizeof(T), [&]{
+    memcpy(spectrum.flatten, signal.flatten, 2*n*sizeof(T));
+    fft.transform(spectrum.flatten);
+  });
+  bench.run<T>("rfft", n, 2*n*sizeof(T), [&]{
+    memcpy(spectrum.flatten, signal.flatten, n*sizeof(T));
+    rfft.transform(spectrum.flatten);
+  });
+}
+
+/**
+ * @brief The same operations on one core and split across both, measured
+ * with interrupts enabled (the calling core waits for the other one)
+ *
+ * @tparam T Array type
+ * @param bench Benchmark
+ * @param length Array length. Matrices are sqrt(length) square.
+ */
+template<typename T>
+void sweepParallel(Benchmark& bench, const size_t length)
+{
+  const size_t kernelLength = 64;
+  size_t size = 1;
+  while ((size + 1)*(size + 1) <= length)
+    size++;
+  Array<T> a(FRACTIONAL, shape2D(1, length));
+  Array<T> b(FRACTIONAL, shape2D(1, length));
+  Array<T> kernel(FRACTIONAL, shape2D(1, kernelLength));
+  Array<T> m1(FRACTIONAL, shape2D(size, size));
+  Array<T> m2(FRACTIONAL, shape2D(size, size));
+  Array<T> result;
+  ArrayStats<T> stats;
+  randomize(a);
+  randomize(b);
+  randomize(kernel);
+  randomize(m1);
+  randomize(m2);
+
+  ParallelConfig& config = parallelism();
+  const ParallelConfig saved = config;
+  config.threshold = 0;
+  for (int cores = 1; cores <= 2; cores++)
+  {
+    const bool one = cores == 1;
+    config.enabled = !one;
+    bench.run<T>(one ? "add_1core" : "add_2cores", length, 3*length*sizeof(T), [&]{result = a + b;}, false);
+    bench.run<T>(one ? "mul_1core" : "mul_2cores", length, 3*length*sizeof(T), [&]{result = a * b;}, false);
+    bench.run<T>(one ? "stats_1core" : "stats_2cores", length, length*sizeof(T), [&]{stats = a.stats();}, false);
+    bench.run<T>(one ? "conv_1core" : "conv_2cores", length, (2*length + 2*kernelLength)*sizeof(T),\
+                 [&]{result = a.conv(kernel);}, false);
+    bench.run<T>(one ? "matmul_1core" : "matmul_2cores", size, 3*size*size*sizeof(T),\
+                 [&]{result = m1.matmul(m2);}, false);
+  }
+  config = saved;
+  (void)stats;
+}
+
+/**
+ * @brief FixedPoint operations with a float operand, through the former float
+ * round trip and through the integer paths. Each case runs `count` scalar
+ * operations.
+ *
+ * The round trip is the former implementation: the float went through
+ * dsps_f32_s16_esp into a FixedPoint, which was multiplied back through
+ * operator float.
+ *
+ * @param bench Benchmark
+ * @param count Operations per case
+ */
+void sweepFixedScalar(Benchmark& bench, const size_t count)
+{
+  Array<int16_t> values(FRACTIONAL, shape2D(1, count));
+  randomize(values);
+  fixed* x = (fixed*)malloc(count*sizeof(fixed));
+  ESP_ERROR_CHECK(x == NULL);
+  volatile float operand = 1.375f;
+  const uint8_t frac = FRACTIONAL;
+
+  auto reset = [&]{
+    for (size_t i = 0; i < count; i++)
+    {
+      x[i].data = values.flatten[i];
+      x[i].frac = frac;
+    }
+  };
+  reset();
+  bench.run<int16_t>("fixed_mulf_roundtrip", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+    {
+      int16_t c;
+      float f = operand, back;
+      dsps_f32_s16_esp(&f, &c, frac);
+      dsps_s16_f32_esp(&c, &back, frac);
+      x[i].data = (int16_t)(x[i].data*back);
+    }
+  });
+  reset();
+  bench.run<int16_t>("fixed_mulf", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+      x[i] *= operand;
+  });
+  reset();
+  bench.run<int16_t>("fixed_mul_literal", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+      x[i] = x[i]*1.375f;
+  });
+  reset();
+  bench.run<int16_t>("fixed_addf_roundtrip", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+    {
+      int16_t c;
+      float f = operand;
+      dsps_f32_s16_esp(&f, &c, frac);
+      x[i].data = (int16_t)(x[i].data + c);
+    }
+  });
+  reset();
+  bench.run<int16_t>("fixed_addf", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+      x[i] += operand;
+  });
+  reset();
+  bench.run<int16_t>("fixed_divf_roundtrip", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+    {
+      int16_t c;
+      float f = operand, back;
+      dsps_f32_s16_esp(&f, &c, frac);
+      dsps_s16_f32_esp(&c, &back, frac);
+      x[i].data = (int16_t)(x[i].data/back);
+    }
+  });
+  reset();
+  bench.run<int16_t>("fixed_divf", count, 0, [&]{
+    for (size_t i = 0; i < count; i++)
+      x[i] /= operand;
+  });
+  free(x);
+}
+
+int main(int argc, char** argv)
+{
+  FILE* output = stdout;
+  size_t samples = 101;
+
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    if (!strcmp(argv[i], "-o"))
+      output = fopen(argv[i + 1], "w");
+    else if (!strcmp(argv[i], "-n"))
+      samples = (size_t)atoi(argv[i + 1]);
+    else
+      output = NULL;
+
+    if (!output)
+    {
+      fprintf(stderr, "usage: %s [-o report.json] [-n samples]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  {
+    Benchmark bench(output, samples);
+    for (size_t length : lengths)
+    {
+      sweep<float>(bench, length);
+      sweep<int32_t>(bench, length);
+      sweep<int16_t>(bench, length);
+      sweep<int8_t>(bench, length);
+      sweepConv<float>(bench, length);
+      sweepConv<int16_t>(bench, length);
+    }
+    for (size_t size : matrixSizes)
+    {
+      sweepMatrix<float>(bench, size);
+      sweepMatrix<int16_t>(bench, size);
+    }
+    for (size_t n : fftSizes)
+    {
+      sweepFft<float>(bench, n);
+      sweepFft<int16_t>(bench, n);
+    }
+    for (size_t length : parallelLengths)
+    {
+      sweepParallel<float>(bench, length);
+      sweepParallel<int16_t>(bench, length);
+    }
+    sweepFixedScalar(bench, 256);
+  }
+
+  if (output != stdout)
+    fclose(output);
+  return 0;
+}
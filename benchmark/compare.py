@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Compare two espmath_benchmark reports.
+
+Usage: compare.py baseline.json candidate.json [--threshold 5]
+
+Prints the median cycles of every case found in both reports and the
+relative change. Exits with 1 when a case got slower than the threshold (%).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as report:
+        results = json.load(report)["results"]
+    return {(r["op"], r["type"], r["length"]): r for r in results}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown (%%) reported as a regression")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    candidate = load(args.candidate)
+    regressions = 0
+
+    print("%-12s %-6s %6s %10s %10s %8s" % ("op", "type", "length", "baseline", "candidate", "change"))
+    for key in sorted(baseline.keys() & candidate.keys()):
+        before = baseline[key]["median"]
+        after = candidate[key]["median"]
+        change = 100.0 * (after - before) / before if before else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  <-- regression"
+            regressions += 1
+        print("%-12s %-6s %6d %10d %10d %+7.1f%%%s" % (key + (before, after, change, flag)))
+
+    for key in sorted(baseline.keys() ^ candidate.keys()):
+        print("%-12s %-6s %6d only in %s" % (key + ("baseline" if key in baseline else "candidate",)))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
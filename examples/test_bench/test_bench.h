@@ -2,6 +2,7 @@
 #define _ESP_ARRAY_TEST_BENCH_H_
 
 #include <Arduino.h>
+#include <utility>
 
 #include "esp_math.h"
 #include "esp_debug.h"
@@ -253,6 +254,1398 @@ inline void test_ari(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
   debug.print("DotProduct Result: " + String(array1 ^ array2));
 }
 
+/**
+ * @brief Test that array results are moved, not copied
+ * 
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the array
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_move(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  shape2D shape = shape2D(1, _ARRAY_LENGTH_);
+  Array<T> array1(shape);
+  Array<T> array2(shape);
+  Array<T> result;
+
+  debug.print("Testing allocations of result = array1 + array2...");
+  size_t allocations = Array<T>::allocations();
+  result = array1 + array2;
+  allocations = Array<T>::allocations() - allocations;
+  if(allocations != 1)
+  {
+    debug.print("Allocations: " + String(allocations));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing move constructor...");
+  T* buffer = result.flatten;
+  allocations = Array<T>::allocations();
+  Array<T> moved(std::move(result));
+  allocations = Array<T>::allocations() - allocations;
+  if(allocations != 0 || moved.flatten != buffer || result.flatten != NULL)
+  {
+    debug.print("Allocations: " + String(allocations));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing move assignment...");
+  allocations = Array<T>::allocations();
+  result = std::move(moved);
+  allocations = Array<T>::allocations() - allocations;
+  if(allocations != 0 || result.flatten != buffer || moved.flatten != NULL)
+  {
+    debug.print("Allocations: " + String(allocations));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test that a chained expression is evaluated in one pass into one buffer
+ * 
+ * a*b + c*d - e is checked element by element against the same operations
+ * applied one at a time, then assigned into an array of the same shape,
+ * which must keep its buffer.
+ * 
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the arrays
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_expression(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  shape2D shape = shape2D(1, _ARRAY_LENGTH_);
+  Array<T> a(shape), b(shape), c(shape), d(shape), e(shape);
+  T output[_ARRAY_LENGTH_];
+
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    a.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    b.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    c.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    d.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    e.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    output[i] = op::Sub::apply(op::Add::apply(op::Mul::apply(a.flatten[i], b.flatten[i], 0), op::Mul::apply(c.flatten[i], d.flatten[i], 0), 0), e.flatten[i], 0);
+  }
+
+  debug.print("Testing a*b + c*d - e...");
+  size_t allocations = Array<T>::allocations();
+  Array<T> result = a*b + c*d - e;
+  allocations = Array<T>::allocations() - allocations;
+  if(allocations != 1 || !(result == output))
+  {
+    debug.print("Allocations: " + String(allocations));
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing a*b + c*d - e against one operation at a time...");
+  Array<T> steps = a*b;
+  steps = steps + c*d;
+  steps = steps - e;
+  if(!(result == steps))
+  {
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(steps.flatten, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing buffer reuse of result = e*d + c*b - a...");
+  T* buffer = result.flatten;
+  allocations = Array<T>::allocations();
+  result = e*d + c*b - a;
+  allocations = Array<T>::allocations() - allocations;
+  if(allocations != 0 || result.flatten != buffer)
+  {
+    debug.print("Allocations: " + String(allocations));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test appending values one at a time
+ * 
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Number of values to append
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_append(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  Array<T> result;
+  T output[_ARRAY_LENGTH_];
+
+  debug.print("Testing append...");
+  size_t allocations = Array<T>::allocations();
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    output[i] = nonZeroRandomNumber<T>(max_random<T>());
+    result << output[i];
+  }
+  allocations = Array<T>::allocations() - allocations;
+  if(!(result == output) || allocations > 32)
+  {
+    debug.print("Allocations: " + String(allocations));
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing shrinkToFit...");
+  result.shrinkToFit();
+  if(!(result == output) || result.capacity() != _ARRAY_LENGTH_)
+  {
+    debug.print("Capacity: " + String(result.capacity()));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test column extraction and decimation through views
+ * 
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Number of rows of the matrix
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_view(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  const size_t columns = 3;
+  Array<T> matrix(shape2D(_ARRAY_LENGTH_, columns));
+  T output[_ARRAY_LENGTH_];
+  for(size_t i = 0; i < matrix.shape.size; i++)
+    matrix.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+
+  debug.print("Testing column view...");
+  size_t allocations = Array<T>::allocations();
+  Array<T> result = matrix.column(0) + matrix.column(1);
+  allocations = Array<T>::allocations() - allocations;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    output[i] = matrix.flatten[i*columns] + matrix.flatten[i*columns + 1];
+  if(!(result == output) || allocations != 1)
+  {
+    debug.print("Allocations: " + String(allocations));
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing assignment to a column view...");
+  matrix.column(2) = matrix.column(0) + matrix.column(1);
+  result = matrix.column(2);
+  if(!(result == output))
+  {
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing decimation...");
+  result = matrix.slice(1, _ARRAY_LENGTH_, columns);
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    output[i] = matrix.flatten[i*columns + 1];
+  if(!(result == output))
+  {
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing unaligned slice view...");
+  result = matrix.slice(1, _ARRAY_LENGTH_) + matrix.slice(2, _ARRAY_LENGTH_);
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    output[i] = matrix.flatten[i + 1] + matrix.flatten[i + 2];
+  if(!(result == output))
+  {
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing rows of an odd width matrix...");
+  matrix.row(1) = matrix.row(2) - matrix.row(0);
+  result = matrix.row(1) + (T)1;
+  for(size_t i = 0; i < columns; i++)
+    output[i] = matrix.flatten[2*columns + i] - matrix.flatten[i] + (T)1;
+  if(!(result == output))
+  {
+    debug.print(result.flatten, columns);
+    debug.print(output, columns);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the matrix product against the definition
+ * 
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Columns of the first matrix
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_matmul(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  const size_t rows = 3;
+  const size_t columns = 6;
+  Array<T> matrix1(shape2D(rows, _ARRAY_LENGTH_));
+  Array<T> matrix2(shape2D(_ARRAY_LENGTH_, columns));
+  T output[rows*columns];
+  /* Small integers: every sum is exact, whatever the order of the additions */
+  for(size_t i = 0; i < matrix1.shape.size; i++)
+    matrix1.flatten[i] = (T)nonZeroRandomNumber<int8_t>(10);
+  for(size_t i = 0; i < matrix2.shape.size; i++)
+    matrix2.flatten[i] = (T)nonZeroRandomNumber<int8_t>(10);
+
+  for(size_t i = 0; i < rows; i++)
+    for(size_t j = 0; j < columns; j++)
+    {
+      int32_t acc = 0;
+      for(size_t p = 0; p < _ARRAY_LENGTH_; p++)
+        acc += (int32_t)(matrix1.flatten[i*_ARRAY_LENGTH_ + p]*matrix2.flatten[p*columns + j]);
+      output[i*columns + j] = (T)acc;
+    }
+
+  debug.print("Testing matrix product...");
+  Array<T> result = matrix1.matmul(matrix2);
+  if(!(result == output) || result.shape != shape2D(rows, columns))
+  {
+    debug.print(result.flatten, rows*columns);
+    debug.print(output, rows*columns);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the fixed point convolution and correlation against a 64 bits reference
+ *
+ * @param _ARRAY_LENGTH_ Length of the signal
+ * @param FRAC Fractional bits of the signal and of the kernel
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+inline void test_conv_fixed(const size_t _ARRAY_LENGTH_ = 5, const uint8_t FRAC = 0, bool _suspend = true)
+{
+  const size_t kernelLength = 13;
+  Array<int16_t> signal(FRAC, shape2D(1, _ARRAY_LENGTH_));
+  Array<int16_t> kernel(FRAC, shape2D(1, kernelLength));
+  int16_t output[_ARRAY_LENGTH_ + kernelLength - 1];
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    signal.flatten[i] = nonZeroRandomNumber<int16_t>(20000);
+  for(size_t i = 0; i < kernelLength; i++)
+    kernel.flatten[i] = nonZeroRandomNumber<int16_t>((1 << FRAC) + 1);
+
+  debug.print("Testing fixed point convolution...");
+  for(size_t n = 0; n < _ARRAY_LENGTH_ + kernelLength - 1; n++)
+  {
+    int64_t acc = 0;
+    for(size_t k = 0; k < kernelLength; k++)
+      if (n >= k && n - k < _ARRAY_LENGTH_) acc += (int32_t)signal.flatten[n - k]*kernel.flatten[k];
+    acc >>= FRAC;
+    output[n] = acc > INT16_MAX ? INT16_MAX : (acc < INT16_MIN ? INT16_MIN : acc);
+  }
+  Array<int16_t> result = signal.conv(kernel);
+  if(!(result == output) || result.shape.size != _ARRAY_LENGTH_ + kernelLength - 1 || result.frac != FRAC)
+  {
+    debug.print(result.flatten, result.shape.size);
+    debug.print(output, _ARRAY_LENGTH_ + kernelLength - 1);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing fixed point correlation...");
+  for(size_t n = 0; n + kernelLength <= _ARRAY_LENGTH_; n++)
+  {
+    int64_t acc = 0;
+    for(size_t m = 0; m < kernelLength; m++)
+      acc += (int32_t)signal.flatten[n + m]*kernel.flatten[m];
+    acc >>= FRAC;
+    output[n] = acc > INT16_MAX ? INT16_MAX : (acc < INT16_MIN ? INT16_MIN : acc);
+  }
+  result = signal.correlation(kernel);
+  if(!(result == output) || result.shape.size != _ARRAY_LENGTH_ - kernelLength + 1)
+  {
+    debug.print(result.flatten, result.shape.size);
+    debug.print(output, _ARRAY_LENGTH_ - kernelLength + 1);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Stream a signal through a Fir in blocks of random sizes, against the direct form
+ *
+ * @tparam T Filter type
+ * @param _ARRAY_LENGTH_ Length of the signal
+ * @param decimation Inputs per output
+ * @param FRAC Number of fractional bits of the coefficients
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_fir(const size_t _ARRAY_LENGTH_ = 5, const size_t decimation = 1, const uint8_t FRAC = 0, bool _suspend = true)
+{
+  const size_t taps = 13;
+  Array<T> signal(shape2D(1, _ARRAY_LENGTH_));
+  Array<T> coefficients(FRAC, shape2D(1, taps));
+  T output[_ARRAY_LENGTH_];
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    signal.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+  for(size_t i = 0; i < taps; i++)
+    coefficients.flatten[i] = nonZeroRandomNumber<T>((1 << FRAC) + 1);
+
+  debug.print("Testing streaming FIR filter...");
+  Fir<T> fir(coefficients, decimation, 16);
+  size_t produced = 0;
+  for(size_t i = 0; i < _ARRAY_LENGTH_;)
+  {
+    const size_t n = std::min((size_t)(rand() % 37 + 1), _ARRAY_LENGTH_ - i);
+    if (i % 2)
+    {
+      /* in place, on an array */
+      Array<T> block(shape2D(1, n));
+      memcpy(block.flatten, signal.flatten + i, n*sizeof(T));
+      const size_t outputs = fir.process(block);
+      memcpy(output + produced, block.flatten, outputs*sizeof(T));
+      produced += outputs;
+    }
+    else
+      produced += fir.process(signal.flatten + i, output + produced, n);
+    i += n;
+  }
+
+  bool failed = produced != _ARRAY_LENGTH_/decimation;
+  for(size_t n = 0; n < produced && !failed; n++)
+  {
+    double acc = 0;
+    for(size_t k = 0; k < taps; k++)
+      if (n*decimation + decimation - 1 >= k) acc += (double)signal.flatten[n*decimation + decimation - 1 - k]*coefficients.flatten[k];
+    if (FRAC) acc = (double)(((int64_t)acc) >> FRAC);
+    failed = !eqFloats(output[n], acc, 0.0001*fabs(acc) + 0.0001);
+    if (failed) debug.print(String(n) + ": " + String((float)output[n]) + " " + String((float)acc));
+  }
+  if (failed)
+  {
+    debug.print("Outputs: " + String(produced));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Stream interleaved channels through an Iir in blocks of random sizes, against the direct form
+ *
+ * @tparam T Filter type
+ * @param _ARRAY_LENGTH_ Number of frames
+ * @param channels Number of interleaved channels
+ * @param FRAC Number of fractional bits of the coefficients
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_iir(const size_t _ARRAY_LENGTH_ = 5, const size_t channels = 1, const uint8_t FRAC = 0, bool _suspend = true)
+{
+  const size_t nsections = 3;
+  /* stable low pass sections, a little detuned from each other */
+  const double sos[nsections][5] = {{0.25, 0.5, 0.25, -0.6, 0.2}, {0.2, 0.4, 0.2, -0.3, 0.1}, {0.5, -0.5, 0.25, 0.4, 0.3}};
+  Array<T> sections(FRAC, shape2D(nsections, 5));
+  for(size_t i = 0; i < sections.shape.size; i++)
+    sections.flatten[i] = (T)(sos[i/5][i%5]*(1 << FRAC));
+  Array<T> signal(shape2D(_ARRAY_LENGTH_, channels));
+  Array<T> output(shape2D(_ARRAY_LENGTH_, channels));
+  for(size_t i = 0; i < signal.shape.size; i++)
+    signal.flatten[i] = nonZeroRandomNumber<T>(FRAC ? 10000 : max_random<T>());
+
+  debug.print("Testing IIR cascade...");
+  Iir<T> iir(sections, channels);
+  for(size_t i = 0, k = 0; i < _ARRAY_LENGTH_; k++)
+  {
+    const size_t n = std::min((size_t)(rand() % 37 + 1), _ARRAY_LENGTH_ - i);
+    if (k % 3 == 0)
+      iir.process(signal.flatten + i*channels, output.flatten + i*channels, n);
+    else
+    {
+      /* in place, on a (frames, channels) array or one column at a time */
+      Array<T> block(shape2D(n, channels));
+      memcpy(block.flatten, signal.flatten + i*channels, n*channels*sizeof(T));
+      if (k % 3 == 1)
+        iir.process(block);
+      else
+        for(size_t c = 0; c < channels; c++)
+          iir.process(block.column(c), c);
+      memcpy(output.flatten + i*channels, block.flatten, n*channels*sizeof(T));
+    }
+    i += n;
+  }
+
+  bool failed = false;
+  for(size_t c = 0; c < channels && !failed; c++)
+  {
+    double state[nsections][4] = {};
+    for(size_t n = 0; n < _ARRAY_LENGTH_ && !failed; n++)
+    {
+      double value = signal.flatten[n*channels + c];
+      for(size_t s = 0; s < nsections; s++)
+      {
+        const T* b = sections.flatten + 5*s;
+        double acc = b[0]*value + b[1]*state[s][0] + b[2]*state[s][1] - b[3]*state[s][2] - b[4]*state[s][3];
+        if (FRAC)
+        {
+          acc = (double)(((int64_t)acc) >> FRAC);
+          acc = acc > INT16_MAX ? INT16_MAX : (acc < INT16_MIN ? INT16_MIN : acc);
+        }
+        state[s][1] = state[s][0];
+        state[s][0] = value;
+        state[s][3] = state[s][2];
+        state[s][2] = acc;
+        value = acc;
+      }
+      failed = !eqFloats(output.flatten[n*channels + c], value, 0.001*fabs(value) + 0.001);
+      if (failed) debug.print(String(n) + ", " + String(c) + ": " + String((float)output.flatten[n*channels + c]) + " " + String((float)value));
+    }
+  }
+  if (failed)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the complex and real FFTs against the direct DFT
+ *
+ * @tparam T Array type
+ * @param _FFT_SIZE_ Number of points, a power of 2
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_fft(const size_t _FFT_SIZE_ = 256, bool _suspend = true)
+{
+  const bool fixed = std::is_integral<T>::value;
+  /* int16_t transforms return X/n, with a couple of LSB lost per pass */
+  const double scale = fixed ? 1.0/_FFT_SIZE_ : 1;
+  const double amplitude = fixed ? 10000 : max_random<T>();
+  Array<T> signal(shape2D(1, 2*_FFT_SIZE_));
+  for(size_t i = 0; i < signal.shape.size; i++)
+    signal.flatten[i] = nonZeroRandomNumber<T>(amplitude);
+
+  debug.print("Testing complex FFT...");
+  Array<T> spectrum = signal;
+  Fft<T>(_FFT_SIZE_).transform(spectrum);
+  double error = 0, peak = 0;
+  for(size_t m = 0; m < _FFT_SIZE_; m++)
+  {
+    double re = 0, im = 0;
+    for(size_t i = 0; i < _FFT_SIZE_; i++)
+    {
+      const double angle = -2*M_PI*((i*m) % _FFT_SIZE_)/_FFT_SIZE_;
+      re += signal.flatten[2*i]*cos(angle) - signal.flatten[2*i + 1]*sin(angle);
+      im += signal.flatten[2*i]*sin(angle) + signal.flatten[2*i + 1]*cos(angle);
+    }
+    error = std::max(error, std::max(fabs(spectrum.flatten[2*m] - re*scale), fabs(spectrum.flatten[2*m + 1] - im*scale)));
+    peak = std::max(peak, std::max(fabs(re*scale), fabs(im*scale)));
+  }
+  if (error > (fixed ? 16 : 0.00001*peak))
+  {
+    debug.print("Error: " + String((float)error) + " Peak: " + String((float)peak));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing real FFT...");
+  spectrum = signal;
+  spectrum.resize(_FFT_SIZE_);
+  Rfft<T>(_FFT_SIZE_).transform(spectrum);
+  error = peak = 0;
+  for(size_t m = 0; m <= _FFT_SIZE_/2; m++)
+  {
+    double re = 0, im = 0;
+    for(size_t i = 0; i < _FFT_SIZE_; i++)
+    {
+      const double angle = -2*M_PI*((i*m) % _FFT_SIZE_)/_FFT_SIZE_;
+      re += signal.flatten[i]*cos(angle);
+      im += signal.flatten[i]*sin(angle);
+    }
+    /* X[0] and X[n/2] are real, packed in the first pair */
+    const double outRe = m == 0 ? spectrum.flatten[0] : (m == _FFT_SIZE_/2 ? spectrum.flatten[1] : spectrum.flatten[2*m]);
+    const double outIm = (m == 0 || m == _FFT_SIZE_/2) ? 0 : spectrum.flatten[2*m + 1];
+    error = std::max(error, std::max(fabs(outRe - re*scale), fabs(outIm - im*scale)));
+    peak = std::max(peak, std::max(fabs(re*scale), fabs(im*scale)));
+  }
+  if (error > (fixed ? 16 : 0.00001*peak))
+  {
+    debug.print("Error: " + String((float)error) + " Peak: " + String((float)peak));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the division by a constant and the float divisions against C division
+ *
+ * Integer quotients must be exact, whatever the divisor (magic numbers or
+ * quos). Float quotients must be within 2^-21 of the exact one, over a wide
+ * range of magnitudes.
+ *
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the array
+ * @param FRAC Fractional part, for int16_t arrays
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_division(const size_t _ARRAY_LENGTH_ = 5, const uint8_t FRAC = 0, bool _suspend = true)
+{
+  const bool fixed = std::is_integral<T>::value;
+  Array<T> data(fixed ? FRAC : 0, shape2D(1, _ARRAY_LENGTH_));
+  Array<T> others(fixed ? FRAC : 0, shape2D(1, _ARRAY_LENGTH_));
+  for(size_t i = 0; i < 2*_ARRAY_LENGTH_; i++)
+  {
+    T& value = i < _ARRAY_LENGTH_ ? data.flatten[i] : others.flatten[i - _ARRAY_LENGTH_];
+    if (fixed)
+      value = (T)esp_random();
+    else
+    {
+      /* Mantissa and exponent at random, [2^-40, 2^40) */
+      const int exponent = (int)(esp_random() % 80) - 40;
+      value = (T)ldexp(1.0 + (esp_random() % 0x800000)/8388608.0, exponent);
+      if (esp_random() % 2) value *= -1;
+    }
+  }
+  if (fixed)
+  {
+    /* lowest()/-1 overflows */
+    data.flatten[0] = std::numeric_limits<T>::max();
+    data.flatten[_ARRAY_LENGTH_ - 1] = std::numeric_limits<T>::lowest() + 1;
+  }
+
+  debug.print("Testing array / constant...");
+  const T divisors[] = {(T)1, (T)-1, (T)2, (T)3, (T)-3, (T)7, (T)10, (T)-100, (T)125,\
+                        (T)std::min<double>(std::numeric_limits<T>::max(), 1e9),\
+                        (T)std::max<double>(std::numeric_limits<T>::lowest(), -1e9),\
+                        nonZeroRandomNumber<T>(max_random<T>()), nonZeroRandomNumber<T>(max_random<T>())};
+  bool failed = false;
+  for(const T divisor : divisors)
+  {
+    Array<T> result = data;
+    result /= divisor;
+    for(size_t i = 0; i < _ARRAY_LENGTH_ && !failed; i++)
+    {
+      const T expected = fixed ? (T)(((int64_t)data.flatten[i] << FRAC)/(int64_t)divisor) : (T)(data.flatten[i]/divisor);
+      const double error = fixed ? (double)(result.flatten[i] != expected) : fabs((result.flatten[i] - expected)/(double)expected);
+      if (error > (fixed ? 0 : 1.0/(1 << 21)))
+      {
+        debug.print("Divisor: " + String((float)divisor) + " Input: " + String((float)data.flatten[i]) +\
+                    " Output: " + String((float)result.flatten[i]) + " Expected: " + String((float)expected));
+        failed = true;
+      }
+    }
+  }
+  if (failed)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  if (fixed)
+    return;
+
+  debug.print("Testing constant / array and array / array...");
+  const Array<T> constantOverData = (T)3.5 / data;
+  const Array<T> quotients = data / others;
+  double error = 0;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const double expected = 3.5/data.flatten[i];
+    error = std::max(error, fabs((constantOverData.flatten[i] - expected)/expected));
+    const double quotient = (double)data.flatten[i]/others.flatten[i];
+    error = std::max(error, fabs((quotients.flatten[i] - quotient)/quotient));
+  }
+  if (error > 1.0/(1 << 21))
+  {
+    debug.print("Relative error: " + String((float)error));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing zero, infinite and NaN divisors...");
+  const T special[] = {(T)0, (T)-0.0, (T)INFINITY, (T)-INFINITY, (T)NAN, (T)1e-30, (T)1e30};
+  const size_t count = sizeof(special)/sizeof(special[0]);
+  Array<T> dividends(shape2D(1, count*count));
+  Array<T> specialDivisors(shape2D(1, count*count));
+  for(size_t i = 0; i < count*count; i++)
+  {
+    dividends.flatten[i] = i/count ? special[i/count] : (T)2.5;
+    specialDivisors.flatten[i] = special[i%count];
+  }
+  const Array<T> specialQuotients = dividends / specialDivisors;
+  const Array<T> overSpecial = (T)2.5 / specialDivisors;
+  failed = false;
+  for(size_t i = 0; i < count*count; i++)
+  {
+    const T expected = dividends.flatten[i]/specialDivisors.flatten[i];
+    const T quotients[] = {specialQuotients.flatten[i], i/count ? expected : overSpecial.flatten[i]};
+    for(const T quotient : quotients)
+    {
+      const bool same = isnan(expected) ? isnan(quotient) : (isinf(expected) || expected == 0 ? quotient == expected && signbit(quotient) == signbit(expected) :\
+                                                              fabs((quotient - expected)/expected) <= 1.0/(1 << 21));
+      if (!same)
+      {
+        debug.print(String((float)dividends.flatten[i]) + " / " + String((float)specialDivisors.flatten[i]) + " = " + String((float)quotient) +\
+                    " Expected: " + String((float)expected));
+        failed = true;
+      }
+    }
+  }
+  if (failed)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing fused quotients against the kernels...");
+  const Array<T> fusedQuotients = dividends / specialDivisors * (T)1;
+  const Array<T> fusedOverSpecial = (T)2.5 / specialDivisors * (T)1;
+  const Array<T> overConstant = data / (T)3.5;
+  const Array<T> fusedOverConstant = data / (T)3.5 * (T)1;
+  const Array<T> fusedOverData = (T)3.5 / data * (T)1;
+  const Array<T> fusedOverOthers = data / others * (T)1;
+  failed = false;
+  for(size_t i = 0; i < count*count; i++)
+    if (!(fusedQuotients.flatten[i] == specialQuotients.flatten[i] || (isnan(fusedQuotients.flatten[i]) && isnan(specialQuotients.flatten[i]))) ||\
+        !(fusedOverSpecial.flatten[i] == overSpecial.flatten[i] || (isnan(fusedOverSpecial.flatten[i]) && isnan(overSpecial.flatten[i]))))
+      failed = true;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    if (fusedOverConstant.flatten[i] != overConstant.flatten[i] || fusedOverData.flatten[i] != constantOverData.flatten[i] ||\
+        fusedOverOthers.flatten[i] != quotients.flatten[i])
+      failed = true;
+  if (failed)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the chunked critical sections of the element-wise kernels
+ *
+ * The results must not depend on the chunking, and the measured critical
+ * sections must stay within the bound, in elements or in cycles.
+ *
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the array
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_chunking(const size_t _ARRAY_LENGTH_ = 8192, bool _suspend = true)
+{
+  Array<T> array1(shape2D(1, _ARRAY_LENGTH_));
+  Array<T> array2(shape2D(1, _ARRAY_LENGTH_));
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    array1.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    array2.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+  }
+  DspChunking& chunking = dspChunking();
+  const DspChunking saved = chunking;
+
+  /* Reference: the whole kernel in one critical section */
+  chunking.elements = 0;
+  chunking.cycles = 0;
+  chunking.resetStats();
+  const Array<T> sum = array1 + array2;
+  const Array<T> product = array1 * array2;
+  bool failed = chunking.sections != 2;
+
+  debug.print("Testing critical sections bounded in elements...");
+  const size_t bound = 1000;
+  const size_t effective = bound - bound % 16;
+  chunking.elements = bound;
+  chunking.resetStats();
+  Array<T> result = array1 + array2;
+  if (!(result == sum) || chunking.longestElements > bound ||\
+      chunking.sections != (_ARRAY_LENGTH_ + effective - 1)/effective)
+  {
+    debug.print("Longest: " + String((int)chunking.longestElements) + " Sections: " + String((int)chunking.sections));
+    failed = true;
+  }
+#if ESP_MATH_HOST
+  failed |= hostInterruptLevel() != 0;
+#endif
+  if (failed)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing critical sections bounded in cycles...");
+  chunking.elements = 0;
+  chunking.cycles = 20000;
+  chunking.resetStats();
+  result = array1 * array2;
+  debug.print("Longest: " + String((int)chunking.longestCycles) + " cycles, " +\
+              String((int)chunking.longestElements) + " elements, " + String((int)chunking.sections) + " sections");
+  /* The first chunk is short, the next ones are sized after it: allow some jitter */
+  if (!(result == product) || chunking.longestCycles > 2*chunking.cycles)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing reductions in bounded critical sections...");
+  chunking.elements = 0;
+  chunking.cycles = 0;
+  const ArrayStats<T> stats = array1.stats();
+  const auto dot = array1 ^ array2;
+  chunking.elements = bound;
+  chunking.resetStats();
+  const ArrayStats<T> chunkedStats = array1.stats();
+  const auto chunkedDot = array1 ^ array2;
+  const double tolerance = std::is_integral<T>::value ? 0 : 0.0001;
+  const double magnitude = (double)_ARRAY_LENGTH_*max_random<T>()*max_random<T>(); /* bound of the sums */
+  if (chunkedStats.min != stats.min || chunkedStats.max != stats.max ||\
+      fabs((double)chunkedStats.sum - stats.sum) > tolerance*magnitude ||\
+      fabs((double)chunkedStats.sumsq - stats.sumsq) > tolerance*magnitude ||\
+      fabs((double)chunkedDot - dot) > tolerance*magnitude || chunking.longestElements > bound ||\
+      chunking.sections != 2*((_ARRAY_LENGTH_ + effective - 1)/effective))
+  {
+    debug.print("Dot: " + String((float)chunkedDot) + " Expected: " + String((float)dot));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing masks in bounded critical sections...");
+  chunking.elements = 0;
+  const ArrayMask mask = array1 > array2.flatten[0];
+  const Array<T> compressed = array1[mask];
+  const Array<T> selected = where(mask, array1, array2);
+  chunking.elements = bound;
+  chunking.resetStats();
+  const ArrayMask chunkedMask = array1 > array2.flatten[0];
+  const Array<T> chunkedCompressed = array1[chunkedMask];
+  const Array<T> chunkedSelected = where(chunkedMask, array1, array2);
+  const size_t words = bound - bound % 32; /* mask kernels run whole mask words */
+  if ((chunkedMask ^ mask).any() || !(chunkedCompressed == compressed) || !(chunkedSelected == selected) ||\
+      chunking.longestElements > bound || chunking.sections != 3*((_ARRAY_LENGTH_ + words - 1)/words))
+  {
+    debug.print("Longest: " + String((int)chunking.longestElements) + " Sections: " + String((int)chunking.sections));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  chunking = saved;
+}
+
+/**
+ * @brief Largest difference between two arrays, relative to the magnitude of the second
+ *
+ * @param len Elements compared, from the first one; 0 compares them all
+ */
+template<typename T>
+inline double relativeError(const Array<T>& array, const Array<T>& reference, const size_t len = 0)
+{
+  if (array.shape.size != reference.shape.size)
+    return INFINITY;
+  double error = 0;
+  for(size_t i = 0; i < (len ? len : array.shape.size); i++)
+  {
+    const double magnitude = fabs((double)reference.flatten[i]);
+    error = std::max(error, fabs((double)array.flatten[i] - reference.flatten[i])/(magnitude > 1 ? magnitude : 1));
+  }
+  return error;
+}
+
+/**
+ * @brief Test the operations split across both cores against the same ones on a single core
+ *
+ * Fixed point results must be identical. Float sums are added in another
+ * order, so they only have to agree within rounding.
+ *
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the arrays
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_parallel(const size_t _ARRAY_LENGTH_ = 4096, bool _suspend = true)
+{
+  const double tolerance = std::is_integral<T>::value ? 0 : 0.0001;
+  Array<T> array1(shape2D(1, _ARRAY_LENGTH_));
+  Array<T> array2(shape2D(1, _ARRAY_LENGTH_));
+  Array<T> matrix1(shape2D(37, 40));
+  Array<T> matrix2(shape2D(40, 24));
+  Array<T> kernel(shape2D(1, 33));
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    array1.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    array2.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+  }
+  for(size_t i = 0; i < matrix1.shape.size; i++)
+    matrix1.flatten[i] = nonZeroRandomNumber<T>(10);
+  for(size_t i = 0; i < matrix2.shape.size; i++)
+    matrix2.flatten[i] = nonZeroRandomNumber<T>(10);
+  for(size_t i = 0; i < kernel.shape.size; i++)
+    kernel.flatten[i] = nonZeroRandomNumber<T>(10);
+
+  ParallelConfig& config = parallelism();
+  const ParallelConfig saved = config;
+  config.enabled = false;
+  const Array<T> sum = array1 + array2;
+  const Array<T> product = array1 * array2;
+  const ArrayStats<T> stats = array1.stats();
+  const Array<T> matrixProduct = matrix1.matmul(matrix2);
+  const Array<T> convolution = array1.conv(kernel);
+  const Array<T> correlation = array1.correlation(kernel);
+  const ArrayMask mask = array1 > array2.flatten[0];
+  const Array<T> compressed = array1[mask];
+  const Array<T> selected = where(mask, array1, array2);
+
+  config.enabled = true;
+  config.threshold = 0;
+  debug.print("Testing element-wise operations on both cores...");
+  if (relativeError<T>(array1 + array2, sum) > tolerance || relativeError<T>(array1 * array2, product) > tolerance)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing reductions on both cores...");
+  const ArrayStats<T> parallelStats = array1.stats();
+  const double magnitude = (double)_ARRAY_LENGTH_*max_random<T>()*max_random<T>(); /* bound of the sums */
+  if (parallelStats.min != stats.min || parallelStats.max != stats.max ||\
+      fabs((double)parallelStats.sum - stats.sum) > tolerance*magnitude ||\
+      fabs((double)parallelStats.sumsq - stats.sumsq) > tolerance*magnitude)
+  {
+    debug.print("Sum: " + String((float)parallelStats.sum) + " Expected: " + String((float)stats.sum));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing matrix product, convolution and correlation on both cores...");
+  if (relativeError(matrix1.matmul(matrix2), matrixProduct) > tolerance ||\
+      relativeError(array1.conv(kernel), convolution) > tolerance ||\
+      relativeError(array1.correlation(kernel), correlation, _ARRAY_LENGTH_ - kernel.shape.size + 1) > tolerance) /* the valid outputs only */
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing masks on both cores...");
+  const ArrayMask parallelMask = array1 > array2.flatten[0];
+  if ((parallelMask ^ mask).any() || !(array1[parallelMask] == compressed) || !(where(parallelMask, array1, array2) == selected))
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  config = saved;
+}
+
+/**
+ * @brief Test the comparison operators and their masks against the elements
+ *
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the array
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_compare(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  Array<T> array(shape2D(1, _ARRAY_LENGTH_));
+  /* Integers, so that float elements are equal or far apart */
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    array.flatten[i] = (T)nonZeroRandomNumber<int8_t>(10);
+  const T value = array.flatten[_ARRAY_LENGTH_/2];
+
+  const ArrayMask masks[] = {array == value, array != value, array < value,\
+                             array >= value, array > value, array <= value};
+  const char* names[] = {"==", "!=", "<", ">=", ">", "<="};
+  for(size_t op = 0; op < 6; op++)
+  {
+    debug.print(String("Testing comparison ") + names[op] + "...");
+    size_t count = 0;
+    size_t failure = _ARRAY_LENGTH_;
+    for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    {
+      const T x = array.flatten[i];
+      const bool expected = op == 0 ? x == value : op == 1 ? x != value : op == 2 ? x < value :\
+                            op == 3 ? x >= value : op == 4 ? x > value : x <= value;
+      count += expected;
+      if (masks[op][i] != expected && failure == _ARRAY_LENGTH_)
+        failure = i;
+    }
+    if (failure != _ARRAY_LENGTH_ || masks[op].count() != count ||\
+        masks[op].any() != (count > 0) || masks[op].all() != (count == _ARRAY_LENGTH_))
+    {
+      debug.print("Index: " + String(failure) + ", count: " + String(masks[op].count()) + " != " + String(count));
+      if (_suspend) vTaskSuspend(NULL);
+    }
+    else
+      debug.print("Succeeded!");
+  }
+
+  debug.print("Testing mask operations...");
+  const ArrayMask between = (array >= value) & (array <= value);
+  if (between.count() != masks[0].count() || (~masks[0] | masks[0]).all() != true || (masks[0] ^ masks[0]).any())
+  {
+    debug.print("Count: " + String(between.count()) + " != " + String(masks[0].count()));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test mask compaction (array[mask]) and where(mask, a, b)
+ *
+ * @tparam T Array type
+ * @param _ARRAY_LENGTH_ Length of the array
+ * @param _suspend If true, it will suspend the main task on failure.
+ */
+template<typename T>
+inline void test_filter(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  Array<T> array1(shape2D(1, _ARRAY_LENGTH_));
+  Array<T> array2(shape2D(1, _ARRAY_LENGTH_));
+  T output[_ARRAY_LENGTH_];
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    array1.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+    array2.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+  }
+  const ArrayMask mask = array1 > array2.flatten[0];
+
+  debug.print("Testing compaction...");
+  size_t length = 0;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    if (array1.flatten[i] > array2.flatten[0]) output[length++] = array1.flatten[i];
+  Array<T> result = array1[mask];
+  if(!(result == output) || result.shape.size != length)
+  {
+    debug.print(result.flatten, result.shape.size);
+    debug.print(output, length);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing where...");
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    output[i] = array1.flatten[i] > array2.flatten[0] ? array1.flatten[i] : array2.flatten[i];
+  result = where(mask, array1, array2);
+  if(!(result == output))
+  {
+    debug.print(result.flatten, _ARRAY_LENGTH_);
+    debug.print(output, _ARRAY_LENGTH_);
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+template<typename T>
+inline void test_stats(const size_t _ARRAY_LENGTH_ = 5, bool _suspend = true)
+{
+  Array<T> array(shape2D(1, _ARRAY_LENGTH_));
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    array.flatten[i] = nonZeroRandomNumber<T>(max_random<T>());
+
+  T minimum = array.flatten[0], maximum = array.flatten[0];
+  size_t argmin = 0, argmax = 0;
+  double sum = 0, sumsq = 0;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const T value = array.flatten[i];
+    if (value < minimum) {minimum = value; argmin = i;}
+    if (value > maximum) {maximum = value; argmax = i;}
+    sum += value;
+    sumsq += (double)value*value;
+  }
+  const double mean = sum/_ARRAY_LENGTH_;
+  const double var = sumsq/_ARRAY_LENGTH_ - mean*mean;
+
+  debug.print("Testing min, max, argmin and argmax...");
+  if (array.min() != minimum || array.max() != maximum || array.argmin() != argmin || array.argmax() != argmax)
+  {
+    debug.print(String((float)array.min()) + " " + String((float)array.max()) + " " + String(array.argmin()) + " " + String(array.argmax()));
+    debug.print(String((float)minimum) + " " + String((float)maximum) + " " + String(argmin) + " " + String(argmax));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing sum, mean, var and norm2...");
+  const ArrayStats<T> stats = array.stats();
+  if (!eqFloats(array.sum(), sum, 0.001*fabs(sum) + 0.001) || !eqFloats(array.mean(), mean, 0.001*fabs(mean) + 0.001) ||\
+      !eqFloats(array.var(), var, 0.001*var + 0.001) || !eqFloats(array.norm2(), sqrt(sumsq), 0.001*sqrt(sumsq)) ||\
+      stats.min != minimum || stats.max != maximum || stats.argmin != argmin || stats.argmax != argmax ||\
+      stats.sum != array.sum() || stats.var != array.var())
+  {
+    debug.print(String((float)array.sum()) + " " + String(array.mean()) + " " + String(array.var()) + " " + String(array.norm2()));
+    debug.print(String((float)sum) + " " + String((float)mean) + " " + String((float)var) + " " + String((float)sqrt(sumsq)));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  if (!std::is_floating_point<T>::value)
+    return;
+
+  debug.print("Testing variance around a large mean...");
+  const size_t length = 4*_ARRAY_LENGTH_ + 3;
+  Array<T> offset(shape2D(1, length));
+  double offsetMean = 0, offsetVar = 0;
+  for(size_t i = 0; i < length; i++)
+  {
+    offset.flatten[i] = (T)(10000 + nonZeroRandomNumber<float>(2));
+    offsetMean += offset.flatten[i];
+  }
+  offsetMean /= length;
+  for(size_t i = 0; i < length; i++)
+    offsetVar += (offset.flatten[i] - offsetMean)*(offset.flatten[i] - offsetMean);
+  offsetVar /= length;
+  const ArrayStats<T> offsetStats = offset.stats();
+  if (!eqFloats(offsetStats.var, offsetVar, 0.001*offsetVar) || !eqFloats(offsetStats.mean, offsetMean, 1e-6*offsetMean))
+  {
+    debug.print(String(offsetStats.mean, 6) + " " + String(offsetStats.var, 6));
+    debug.print(String((float)offsetMean, 6) + " " + String((float)offsetVar, 6));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test Fixed<FRAC> mixed format arithmetic against integer references
+ */
+inline void test_fixed_template(const size_t _ARRAY_LENGTH_ = 50, bool _suspend = true)
+{
+  static_assert(Fixed<14>(0.75f).data == 12288, "Fixed<14>(0.75f) must be converted at compile time");
+  size_t failures = 0;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const Fixed<12> a = nonZeroRandomNumber<float>(2);
+    const Fixed<10> b = nonZeroRandomNumber<float>(2);
+    const int32_t aligned = (int32_t)b.data << 2;
+    const Fixed<22, int32_t> product = a*b;
+    const Fixed<12> rounded = product;
+    const Fixed<12> quotient = a/b;
+    const Fixed<4> wide = 64*a.toFloat(); /* widened to Q31 by a large shift */
+    if ((a + b).data != (int16_t)(a.data + aligned) || (a - b).data != (int16_t)(a.data - aligned) ||\
+        product.data != (int32_t)a.data*b.data || rounded.data != (int16_t)((product.data + (1 << 9)) >> 10) ||\
+        quotient.data != (int16_t)(((int32_t)a.data << 10)/b.data) || (a < b) != (a.data < aligned) ||\
+        Fixed<10>(a).data != (int16_t)((a.data + 2) >> 2) ||\
+        (wide > q31(0.5f)) != (wide.toFloat() > 0.5f) || (wide < q31(0.5f)) != (wide.toFloat() < 0.5f))
+    {
+      debug.print(String(a.toFloat(), 4) + " " + String(b.toFloat(), 4) + " " + String(product.toFloat(), 4) + " " + String(quotient.toFloat(), 4));
+      failures++;
+    }
+  }
+  if (failures)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing float operands out of the format and zero divisors...");
+  failures = 0;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const Fixed<15> a = nonZeroRandomNumber<float>(2)/64;
+    const float operand = 4*nonZeroRandomNumber<float>(2); /* mostly out of Q15 */
+    const float x = a.toFloat();
+    const float quotient = x/operand;
+    if (fabs((a*operand).toFloat() - x*operand) > 1.f/(1 << 13) || fabs((operand*a).toFloat() - x*operand) > 1.f/(1 << 13) ||\
+        (fabs(quotient) < 0.99f && fabs((a/operand).toFloat() - quotient) > 1.f/(1 << 12)))
+    {
+      debug.print(String(x, 4) + " " + String(operand, 4));
+      failures++;
+    }
+    const int16_t infinite = a.data > 0 ? INT16_MAX : INT16_MIN;
+    fixed p(x, 15), zero(0.f, 15);
+    p /= zero;
+    if ((a/0.0f).data != infinite || (a/Fixed<12>()).data != infinite || (x/Fixed<15>()).data != infinite ||\
+        (Fixed<15>()/Fixed<15>()).data != 0 || p.data != infinite)
+      failures++;
+  }
+  if (failures)
+  {
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Test the 32 bits fixed point converters and Array<int32_t> arithmetic
+ * with frac against 64 bits references
+ */
+inline void test_fixed32(const size_t _ARRAY_LENGTH_ = 50, const uint8_t FRAC = 16, bool _suspend = true)
+{
+  float values[_ARRAY_LENGTH_], others[_ARRAY_LENGTH_], back[_ARRAY_LENGTH_];
+  const float range = FRAC == 31 ? 0.99f : 100.f;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    values[i] = (float)(esp_random()%20001)/10000.f*range - range;
+    others[i] = nonZeroRandomNumber<float>(2);
+    others[i] = FRAC == 31 ? others[i]/2 : others[i];
+  }
+  Array<int32_t> data(FRAC, shape2D(1, _ARRAY_LENGTH_));
+  Array<int32_t> divisors(FRAC, shape2D(1, _ARRAY_LENGTH_));
+  dsps_f32_s32_esp(values, data.flatten, FRAC, _ARRAY_LENGTH_);
+  dsps_f32_s32_esp(others, divisors.flatten, FRAC, _ARRAY_LENGTH_);
+  const int32_t constant = divisors.flatten[0];
+
+  debug.print("Testing float conversions...");
+  dsps_s32_f32_esp(data.flatten, back, FRAC, _ARRAY_LENGTH_);
+  size_t failures = 0;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    failures += fabs(back[i] - values[i]) > fabs(values[i])*1e-6f + 1.f/(1 << (FRAC > 23 ? 23 : FRAC));
+  if (failures)
+  {
+    debug.print(String(failures) + " conversions differ");
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing multiplication and division...");
+  Array<int32_t> product = data;
+  product *= divisors;
+  Array<int32_t> scaled = data;
+  scaled *= constant;
+  Array<int32_t> quotient = data;
+  quotient /= divisors;
+  Array<int32_t> divided = data;
+  divided /= constant;
+  failures = 0;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const int64_t x = data.flatten[i], d = divisors.flatten[i];
+    failures += product.flatten[i] != (int32_t)((x*d) >> FRAC) || scaled.flatten[i] != (int32_t)((x*constant) >> FRAC) ||\
+                quotient.flatten[i] != (int32_t)((x << FRAC)/d) || divided.flatten[i] != (int32_t)((x << FRAC)/constant);
+  }
+  if (failures || product.frac != FRAC)
+  {
+    debug.print(String(failures) + " results differ");
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing fused expressions...");
+  Array<int32_t> fusedProduct = data*divisors + data;
+  Array<int32_t> fusedQuotient = data/divisors + data;
+  Array<int32_t> fusedScaled = data*constant + data;
+  Array<int32_t> fusedInverted = constant/divisors + data;
+  Array<int32_t> inverted = constant/divisors;
+  failures = 0;
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const int32_t x = data.flatten[i];
+    failures += fusedProduct.flatten[i] != (int32_t)((uint32_t)product.flatten[i] + (uint32_t)x) ||\
+                fusedQuotient.flatten[i] != (int32_t)((uint32_t)quotient.flatten[i] + (uint32_t)x) ||\
+                fusedScaled.flatten[i] != (int32_t)((uint32_t)scaled.flatten[i] + (uint32_t)x) ||\
+                fusedInverted.flatten[i] != (int32_t)((uint32_t)inverted.flatten[i] + (uint32_t)x);
+  }
+  if (failures || fusedProduct.frac != FRAC)
+  {
+    debug.print(String(failures) + " results differ");
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing q16_16 and q31...");
+  const q16_16 integral = q16_16(1000.5f)*q16_16(-3.25f);
+  const q31 gain = q31(0.75f)*q31(-0.5f);
+  if (integral.data != (int32_t)(-3251.625*65536) || gain.data != -(int32_t)(0.375*2147483648.0))
+  {
+    debug.print(String(integral.toFloat(), 4) + " " + String(gain.toFloat(), 6));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+}
+
+/**
+ * @brief Expected int16 result of an exact value under a rounding and an overflow mode
+ */
+inline int16_t fixedModeExpected(const double exact, const bool product, const FixedRounding rounding, const FixedOverflow overflow)
+{
+  double rounded = exact;
+  if (rounding == FIXED_TRUNCATE)
+    rounded = product ? floor(exact) : trunc(exact);
+  else if (rounding == FIXED_NEAREST)
+    rounded = product ? floor(exact + 0.5) : round(exact);
+  else
+    rounded = nearbyint(exact); /* ties to even */
+  const int64_t value = (int64_t)rounded;
+  if (overflow == FIXED_SATURATE)
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  return (int16_t)(int32_t)value;
+}
+
+inline void test_fixed_modes(const size_t _ARRAY_LENGTH_ = 50, const uint8_t FRAC = 8, bool _suspend = true)
+{
+  const shape2D shape(1, _ARRAY_LENGTH_);
+  Array<int16_t> array1(FRAC, shape);
+  Array<int16_t> array2(FRAC, shape);
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    array1.flatten[i] = (int16_t)esp_random();
+    array2.flatten[i] = (int16_t)(nonZeroRandomNumber<int16_t>(256)*(esp_random()%2 ? 1 : -1));
+  }
+  /* Halves, rounded differently by each mode */
+  array1.flatten[0] = 3 << (FRAC - 1); array2.flatten[0] = 1;
+  array1.flatten[1] = 1 << (FRAC - 1); array2.flatten[1] = 1;
+  array1.flatten[2] = -3;              array2.flatten[2] = 2 << FRAC;
+  const int16_t constant = array2.flatten[esp_random()%_ARRAY_LENGTH_];
+  const double scale = 1 << FRAC;
+  const FixedArithmetic previous = fixedArithmetic();
+  const FixedRounding roundings[] = {FIXED_TRUNCATE, FIXED_NEAREST, FIXED_CONVERGENT};
+  const FixedOverflow overflows[] = {FIXED_WRAP, FIXED_SATURATE};
+
+  for (const FixedOverflow overflow : overflows)
+    for (const FixedRounding rounding : roundings)
+    {
+      debug.print("Testing overflow " + String((int)overflow) + ", rounding " + String((int)rounding) + "...");
+      fixedArithmetic().overflow = overflow;
+      fixedArithmetic().rounding = rounding;
+      Array<int16_t> product = array1*array2;
+      Array<int16_t> scaled = array1*constant;
+      Array<int16_t> quotient = array1/array2;
+      Array<int16_t> divided = array1/constant;
+      Array<int16_t> inverted = constant/array2;
+      Array<int16_t> fused = array1*array2 + array1;
+      /* With wrap and truncate, array * constant keeps the saturating plain kernel */
+      const FixedOverflow scaledOverflow = fixedArithmetic().plain() ? FIXED_SATURATE : overflow;
+      size_t failures = 0;
+      for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+      {
+        const double x = array1.flatten[i], d = array2.flatten[i];
+        const int16_t p = fixedModeExpected(x*d/scale, true, rounding, overflow);
+        const int32_t sum = (int32_t)p + array1.flatten[i];
+        failures += product.flatten[i] != p ||\
+                    scaled.flatten[i] != fixedModeExpected(x*constant/scale, true, rounding, scaledOverflow) ||\
+                    quotient.flatten[i] != fixedModeExpected(x*scale/d, false, rounding, overflow) ||\
+                    divided.flatten[i] != fixedModeExpected(x*scale/constant, false, rounding, overflow) ||\
+                    inverted.flatten[i] != fixedModeExpected(constant*scale/d, false, rounding, overflow) ||\
+                    fused.flatten[i] != (int16_t)(sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum));
+      }
+      fixed a, b;
+      a.frac = b.frac = FRAC;
+      a.data = array1.flatten[0], b.data = array1.flatten[1];
+      failures += (a*b).data != fixedModeExpected((double)a.data*b.data/scale, true, rounding, overflow) ||\
+                  (a/b).data != fixedModeExpected(a.data*scale/b.data, false, rounding, overflow);
+      if (failures)
+      {
+        debug.print(String(failures) + " results differ");
+        if (_suspend) vTaskSuspend(NULL);
+      }
+      else
+        debug.print("Succeeded!");
+    }
+  fixedArithmetic() = previous;
+}
+
+inline void test_fixed_align(const size_t _ARRAY_LENGTH_ = 50, const uint8_t FRAC1 = 8, const uint8_t FRAC2 = 12, bool _suspend = true)
+{
+  const shape2D shape(1, _ARRAY_LENGTH_);
+  Array<int16_t> array1(FRAC1, shape);
+  Array<int16_t> array2(FRAC2, shape);
+  for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    array1.flatten[i] = (int16_t)esp_random();
+    array2.flatten[i] = (int16_t)(nonZeroRandomNumber<int16_t>(4096)*(esp_random()%2 ? 1 : -1));
+  }
+  const double scale1 = 1 << FRAC1, scale2 = 1 << FRAC2;
+  const FixedArithmetic previous = fixedArithmetic();
+  const FixedResult results[] = {FIXED_RESULT_LEFT, FIXED_RESULT_FINER, FIXED_RESULT_COARSER};
+  const FixedRounding roundings[] = {FIXED_TRUNCATE, FIXED_NEAREST, FIXED_CONVERGENT};
+
+  fixedArithmetic().overflow = FIXED_SATURATE;
+  for (const FixedResult result : results)
+    for (const FixedRounding rounding : roundings)
+    {
+      debug.print("Testing result format " + String((int)result) + ", rounding " + String((int)rounding) + "...");
+      fixedArithmetic().result = result;
+      fixedArithmetic().rounding = rounding;
+      const uint8_t FRAC = fixedArithmetic().format(FRAC1, FRAC2);
+      const double scale = 1 << FRAC;
+      Array<int16_t> sum = array1 + array2;
+      Array<int16_t> difference = array1 - array2;
+      Array<int16_t> product = array1*array2;
+      Array<int16_t> quotient = array1/array2;
+      Array<int16_t> chained = array1 + array2 - array2;
+      Array<int16_t> stepwise = sum - array2;
+      Array<int16_t> accumulated = array1;
+      accumulated += array2;
+      size_t failures = sum.frac != FRAC || product.frac != FRAC || chained.frac != FRAC || accumulated.frac != FRAC1;
+      for (size_t i = 0; i < _ARRAY_LENGTH_; i++)
+      {
+        const double x = array1.flatten[i]/scale1, d = array2.flatten[i]/scale2;
+        failures += sum.flatten[i] != fixedModeExpected((x + d)*scale, true, rounding, FIXED_SATURATE) ||\
+                    difference.flatten[i] != fixedModeExpected((x - d)*scale, true, rounding, FIXED_SATURATE) ||\
+                    product.flatten[i] != fixedModeExpected(x*d*scale, true, rounding, FIXED_SATURATE) ||\
+                    quotient.flatten[i] != fixedModeExpected(x/d*scale, false, rounding, FIXED_SATURATE) ||\
+                    chained.flatten[i] != stepwise.flatten[i] ||\
+                    accumulated.flatten[i] != fixedModeExpected((x + d)*scale1, true, rounding, FIXED_SATURATE);
+      }
+      if (failures)
+      {
+        debug.print(String(failures) + " results differ");
+        if (_suspend) vTaskSuspend(NULL);
+      }
+      else
+        debug.print("Succeeded!");
+    }
+  fixedArithmetic() = previous;
+}
+
 inline void vint16tofixed(int16_t* in, fixed* out, int len, int frac)
 {
   for (int i = 0; i < len; i++)
@@ -363,7 +1756,75 @@ inline void test_fixed_point(const size_t _ARRAY_LENGTH_ = 5, const uint8_t FRAC
     debug.print("Succeeded!");
 
   debug.print("Testing dot product...");
-  debug.print("DotProduct Result: " + String(fixed2float(array1 ^ array2, FRAC), 4));
+  int64_t dot = 0;
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+    dot += (int32_t)array1.flatten[i]*array2.flatten[i];
+  const int32_t dotResult = array1 ^ array2;
+  if(dotResult != (int32_t)(dot >> FRAC))
+  {
+    debug.print("DotProduct Result: " + String(fixed2float(dotResult, FRAC), 4));
+    debug.print("Expected: " + String(fixed2float((int32_t)(dot >> FRAC), FRAC), 4));
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing operations with floats...");
+  size_t failures = 0;
+  const float operand = (float)randomConstant;
+  const double lsb = 1.0/(1 << FRAC), limit = INT16_MAX*lsb; /* results out of the format wrap around */
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const double x = (double)data1[i].data*lsb, c = (double)FixedPoint::toFixed(operand, FRAC)*lsb;
+    const fixed sum = data1[i] + operand, product = data1[i]*operand, quotient = data1[i]/operand;
+    failures += (fabs(x + c) < limit && fabs((double)sum.data*lsb - (x + c)) > lsb/2) ||\
+                (fabs(x*c) < limit && fabs((double)product.data*lsb - x*c) > lsb/2) ||\
+                (fabs(x/c) < limit && fabs((double)quotient.data*lsb - x/c) > lsb/2) ||\
+                (data1[i]*3).data != (int16_t)(data1[i].data*3);
+  }
+  /* An operand out of the range of Q(FRAC), exact in a coarser format */
+  const float wide = 0.75f*(float)(1 << (16 - FRAC));
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    const double x = (double)data1[i].data*lsb;
+    const fixed product = data1[i]*wide, quotient = data1[i]/wide;
+    failures += (fabs(x*wide) < limit && fabs((double)product.data*lsb - x*wide) > lsb/2) ||\
+                fabs((double)quotient.data*lsb - x/wide) > lsb/2;
+  }
+  if (failures)
+  {
+    debug.print(String(failures) + " results differ");
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
+
+  debug.print("Testing saturated sums with floats and integers...");
+  FixedArithmetic& arithmetic = fixedArithmetic();
+  const FixedArithmetic saved = arithmetic;
+  arithmetic.overflow = FIXED_SATURATE;
+  failures = 0;
+  const float beyond = 2*(float)limit; /* out of Q(FRAC) whatever the other operand */
+  const int32_t integer = 1 << (16 - FRAC);
+  for(size_t i = 0; i < _ARRAY_LENGTH_; i++)
+  {
+    fixed sum = data1[i];
+    sum += beyond;
+    fixed difference = data1[i];
+    difference -= beyond;
+    failures += sum.data != INT16_MAX || difference.data != INT16_MIN || (beyond - data1[i]).data != INT16_MAX ||\
+                (data1[i] + integer).data != INT16_MAX || (data1[i] - integer).data != INT16_MIN ||\
+                fixed(beyond, FRAC).data != INT16_MAX || fixed(-beyond, FRAC).data != INT16_MIN;
+  }
+  failures += (Fixed<12>(7.5f) + Fixed<12>(0.75f)).data != INT16_MAX || (Fixed<12>(-7.5f) - 0.75f).data != INT16_MIN;
+  arithmetic = saved;
+  if (failures)
+  {
+    debug.print(String(failures) + " results differ");
+    if (_suspend) vTaskSuspend(NULL);
+  }
+  else
+    debug.print("Succeeded!");
 }
 
 #endif
\ No newline at end of file
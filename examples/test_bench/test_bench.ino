@@ -27,8 +27,117 @@ void setup(){
   test_fixed_point(array_length, FRACTIONAL);
   debug.print("----------------------------------------------------------------------");
   debug.print("----------------------------------------------------------------------");
+  debug.print("Testing compile-time fixed point formats...");
+  test_fixed_template(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing 32 bits fixed point arrays...");
+  test_fixed32(array_length, 16);
+  test_fixed32(array_length, 31);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing fixed point rounding and overflow modes...");
+  test_fixed_modes(array_length, 8);
+  test_fixed_modes(array_length, 12);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing mixed format fixed point arrays...");
+  test_fixed_align(array_length, 8, 12);
+  test_fixed_align(array_length, 12, 8);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
   debug.print("Testing integer 8 bits arrays arithmetic...");
   test_ari<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing move semantics...");
+  test_move<float>(array_length);
+  test_move<int16_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing fused expressions...");
+  test_expression<float>(array_length);
+  test_expression<int32_t>(array_length);
+  test_expression<int16_t>(array_length);
+  test_expression<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing append...");
+  test_append<float>(array_length);
+  test_append<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing views...");
+  test_view<float>(array_length);
+  test_view<int16_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing matrix product...");
+  test_matmul<float>(array_length);
+  test_matmul<int16_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing fixed point convolution...");
+  test_conv_fixed(array_length, FRACTIONAL);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing streaming FIR filters...");
+  test_fir<float>(array_length);
+  test_fir<float>(array_length, 3);
+  test_fir<int16_t>(array_length, 1, FRACTIONAL);
+  test_fir<int16_t>(array_length, 3, FRACTIONAL);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing IIR cascades...");
+  test_iir<float>(array_length);
+  test_iir<float>(array_length, 2);
+  test_iir<int16_t>(array_length, 1, 14);
+  test_iir<int16_t>(array_length, 2, 14);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing FFTs...");
+  test_fft<float>(1024);
+  test_fft<float>(512);
+  test_fft<int16_t>(1024);
+  test_fft<int16_t>(512);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing divisions...");
+  test_division<float>(array_length);
+  test_division<int32_t>(array_length);
+  test_division<int16_t>(array_length, FRACTIONAL);
+  test_division<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing chunked critical sections...");
+  test_chunking<float>();
+  test_chunking<int16_t>();
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing parallel execution...");
+  test_parallel<float>();
+  test_parallel<int16_t>();
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing comparisons...");
+  test_compare<float>(array_length);
+  test_compare<int32_t>(array_length);
+  test_compare<int16_t>(array_length);
+  test_compare<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing filters...");
+  test_filter<float>(array_length);
+  test_filter<int32_t>(array_length);
+  test_filter<int16_t>(array_length);
+  test_filter<int8_t>(array_length);
+  debug.print("----------------------------------------------------------------------");
+  debug.print("----------------------------------------------------------------------");
+  debug.print("Testing statistics...");
+  test_stats<float>(array_length);
+  test_stats<int32_t>(array_length);
+  test_stats<int16_t>(array_length);
+  test_stats<int8_t>(array_length);
   debug.print("Completed!");
   debug.print("Free size[bytes]: " + String(xPortGetFreeHeapSize()));
   debug.print("----------------------------------------------------------------------");
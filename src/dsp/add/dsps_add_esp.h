@@ -1,8 +1,11 @@
 #ifndef _custom_dsps_add_H_
 #define _custom_dsps_add_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
+#include "../fixed/dsps_fixed_mode.h"
 
+#if !ESP_MATH_HOST
 #include "dsps_add_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -119,6 +122,39 @@ esp_err_t dsps_add_f32_esp(const float *x1,\
                           int step_x2 = 1,\
                           int step_y = 1);
 
+/**
+ * @brief   add fixed point arrays of different formats
+ *
+ * y[i] = x1[i]+x2[i]; i=[0..len), x1 in Q(frac_x1), x2 in Q(frac_x2), y in Q(frac_y)
+ * Both inputs are aligned to the finer of their formats inside the loop, so
+ * no rescale pass is needed before the operation. The result is rounded as
+ * mode says when frac_y is coarser, and always saturated.
+ * 
+ * @param x1: input array
+ * @param x2: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param frac_x1: Fractional part of x1
+ * @param frac_x2: Fractional part of x2
+ * @param frac_y: Fractional part of y
+ * @param mode: DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_add_s16_q_esp(const int16_t *x1,\
+                             const int16_t *x2,\
+                             int16_t *y,\
+                             int len,\
+                             int step_x1,\
+                             int step_x2,\
+                             int step_y,\
+                             int frac_x1,\
+                             int frac_x2,\
+                             int frac_y,\
+                             int mode = DSPS_FIXED_TRUNCATE);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,68 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_add_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_add_s8_esp(const int8_t *x1, const int8_t *x2, int8_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(y + i, vadds(vload<v_s8>(x1 + i), vload<v_s8>(x2 + i)));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = sat8((int32_t)x1[i*step_x1] + x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_add_s16_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vadds(vload<v_s16>(x1 + i), vload<v_s16>(x2 + i)) >> frac);
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = sat16((int32_t)x1[i*step_x1] + x2[i*step_x2]) >> frac;
+  return ESP_OK;
+}
+
+esp_err_t dsps_add_s16_q_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac_x1, int frac_x2, int frac_y, int mode)
+{
+  for (int i = 0; i < len; i++)
+    y[i*step_y] = dsps_fixed_add_q_s16(x1[i*step_x1], frac_x1, x2[i*step_x2], frac_x2, frac_y, mode);
+  return ESP_OK;
+}
+
+esp_err_t dsps_add_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(y + i, (v_s32)((v_u32)vload<v_s32>(x1 + i) + (v_u32)vload<v_s32>(x2 + i)));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = wadd32(x1[i*step_x1], x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_add_f32_esp(const float *x1, const float *x2, float *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(y + i, vload<v_f32>(x1 + i) + vload<v_f32>(x2 + i));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = x1[i*step_x1] + x2[i*step_x2];
+  return ESP_OK;
+}
+
+#endif
@@ -1,8 +1,10 @@
 #ifndef _custom_dsps_addc_H_
 #define _custom_dsps_addc_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
 
+#if !ESP_MATH_HOST
 #include "dsps_addc_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
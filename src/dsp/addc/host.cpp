@@ -0,0 +1,75 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_addc_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_addc_s8_esp(const int8_t *x, int8_t *y, int len, const int8_t *C, int step_x, int step_y)
+{
+  const int32_t c = *C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s8 c_v = vbroadcast<v_s8>(*C);
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(y + i, vadds(vload<v_s8>(x + i), c_v));
+  }
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = sat8(x[i*step_x] + c);
+  return ESP_OK;
+}
+
+esp_err_t dsps_addc_s16_esp(const int16_t *x, int16_t *y, int len, const int16_t *C, int step_x, int step_y, int frac)
+{
+  const int32_t c = *C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(*C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vadds(vload<v_s16>(x + i), c_v) >> frac);
+  }
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = sat16(x[i*step_x] + c) >> frac;
+  return ESP_OK;
+}
+
+esp_err_t dsps_addc_s32_esp(const int32_t *x, int32_t *y, int len, const int32_t C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_u32 c_v = vbroadcast<v_u32>((uint32_t)C);
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(y + i, (v_s32)((v_u32)vload<v_s32>(x + i) + c_v));
+  }
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = wadd32(x[i*step_x], C);
+  return ESP_OK;
+}
+
+esp_err_t dsps_addc_f32_esp(const float *x, float *y, int len, const float C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_f32 c_v = vbroadcast<v_f32>(C);
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(y + i, vload<v_f32>(x + i) + c_v);
+  }
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = x[i*step_x] + C;
+  return ESP_OK;
+}
+
+#endif
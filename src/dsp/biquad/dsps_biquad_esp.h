@@ -0,0 +1,84 @@
+#ifndef _custom_dsps_biquad_H_
+#define _custom_dsps_biquad_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Cascade of second order sections (direct form II transposed)
+ *
+ * Every section computes, with coef = {b0, b1, b2, a1, a2} and state = {s0, s1}:
+ * y = b0*x + s0; s0 = b1*x - a1*y + s1; s1 = b2*x - a2*y
+ * and feeds the next one. The sections are applied one after the other over
+ * the whole block, the first one reads x and writes y, the next ones filter y
+ * in place, so x may be y.
+ * On ESP32 devices each section runs on the FPU (madd.s/msub.s) with its
+ * coefficients and state held in registers.
+ *
+ * @param x: input array, len elements step elements apart
+ * @param y: output array, len elements step elements apart
+ * @param len: amount of samples
+ * @param coef: 5 coefficients per section
+ * @param state: 2 state values per section, updated
+ * @param nsections: amount of sections
+ * @param step: distance between two samples, e.g. the number of interleaved channels
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_f32_esp(const float *x,\
+                              float *y,\
+                              int len,\
+                              const float *coef,\
+                              float *state,\
+                              int nsections,\
+                              int step);
+
+/**
+ * @brief Cascade of second order sections for fixed point samples (direct form I)
+ *
+ * Every section computes, with coef = {b0, b1, b2, a1, a2} and state = {x1, x2, y1, y2}:
+ * y = sat16((b0*x + b1*x1 + b2*x2 - a1*y1 - a2*y2) >> shift)
+ * and feeds the next one. The products are accumulated without any loss
+ * (40 bits accumulator) and shifted once, so with shift as the fractional
+ * bits of the coefficients y keeps the fixed point format of x. Since a1 is
+ * often out of [-1, 1), a Q14 or Q13 set of coefficients (shift 14 or 13)
+ * gives the headroom.
+ * The sections are applied one after the other over the whole block, the
+ * first one reads x and writes y, the next ones filter y in place, so x may be y.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * the coefficients are held in the MAC16 registers (mul.da/mula.da/muls.da).
+ *
+ * @param x: input array, len elements step elements apart
+ * @param y: output array, len elements step elements apart
+ * @param len: amount of samples
+ * @param coef: 5 coefficients per section
+ * @param state: 4 state values per section, updated
+ * @param nsections: amount of sections
+ * @param step: distance between two samples, e.g. the number of interleaved channels
+ * @param shift: right shift applied to the accumulated products, up to 15
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_biquad_s16_esp(const int16_t *x,\
+                              int16_t *y,\
+                              int len,\
+                              const int16_t *coef,\
+                              int16_t *state,\
+                              int nsections,\
+                              int step,\
+                              int shift);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_biquad_H_
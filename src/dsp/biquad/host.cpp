@@ -0,0 +1,64 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_biquad_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/*
+ * A recursive filter depends on its previous output, so each section is a
+ * scalar loop over the block, as on the device.
+ */
+
+esp_err_t dsps_biquad_f32_esp(const float *x, float *y, int len, const float *coef, float *state, int nsections, int step)
+{
+  if (NULL == x || NULL == y || NULL == coef || NULL == state)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  for (int s = 0; s < nsections; s++, coef += 5, state += 2, x = y)
+  {
+    const float b0 = coef[0], b1 = coef[1], b2 = coef[2], a1 = coef[3], a2 = coef[4];
+    float s0 = state[0], s1 = state[1];
+    for (int i = 0; i < len; i++)
+    {
+      const float in = x[i*step];
+      const float out = b0*in + s0;
+      s0 = b1*in - a1*out + s1;
+      s1 = b2*in - a2*out;
+      y[i*step] = out;
+    }
+    state[0] = s0;
+    state[1] = s1;
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_biquad_s16_esp(const int16_t *x, int16_t *y, int len, const int16_t *coef, int16_t *state, int nsections, int step, int shift)
+{
+  if (NULL == x || NULL == y || NULL == coef || NULL == state)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  for (int s = 0; s < nsections; s++, coef += 5, state += 4, x = y)
+  {
+    int16_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+    for (int i = 0; i < len; i++)
+    {
+      const int16_t in = x[i*step];
+      const int64_t acc = (int64_t)coef[0]*in + (int32_t)coef[1]*x1 + (int32_t)coef[2]*x2\
+                          - (int32_t)coef[3]*y1 - (int32_t)coef[4]*y2;
+      x2 = x1;
+      x1 = in;
+      y2 = y1;
+      y1 = sat16(sat32(acc) >> shift);
+      y[i*step] = y1;
+    }
+    state[0] = x1;
+    state[1] = x2;
+    state[2] = y1;
+    state[3] = y2;
+  }
+  return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef _custom_dsps_cmp_H_
+#define _custom_dsps_cmp_H_
+#include "../../esp_platform.h"
+
+/**
+ * @brief Comparisons performed by the dsps_cmp_* kernels
+ *
+ * The lowest bit tells whether the result is negated: every comparison is
+ * computed as one of eq, lt, gt (DSPS_CMP_EQ, DSPS_CMP_LT, DSPS_CMP_GT)
+ * and inverted for its complement.
+ */
+#define DSPS_CMP_EQ 0   /* x == C */
+#define DSPS_CMP_NE 1   /* x != C */
+#define DSPS_CMP_LT 2   /* x <  C */
+#define DSPS_CMP_GE 3   /* x >= C */
+#define DSPS_CMP_GT 4   /* x >  C */
+#define DSPS_CMP_LE 5   /* x <= C */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Compare every element of an array with a constant into a bitmask
+ *
+ * Bit i of the mask (bit i%32 of mask[i/32]) is set when x[i] op C holds.
+ * The bits of the last word past len are cleared, so the mask takes
+ * (len + 31)/32 words.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * 32 elements are compared (ee.vcmp.*) and packed into a mask word at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param mask: output bitmask
+ * @param len: amount of elements
+ * @param C: constant value
+ * @param op: comparison, one of DSPS_CMP_*
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cmp_s8_esp(const int8_t *x,\
+                          uint32_t *mask,\
+                          int len,\
+                          const int8_t *C,\
+                          int op,\
+                          int step_x = 1);
+
+/**
+ * @brief Compare every element of an array with a constant into a bitmask
+ *
+ * Bit i of the mask (bit i%32 of mask[i/32]) is set when x[i] op C holds.
+ * The bits of the last word past len are cleared, so the mask takes
+ * (len + 31)/32 words.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * 32 elements are compared (ee.vcmp.*) and packed into a mask word at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param mask: output bitmask
+ * @param len: amount of elements
+ * @param C: constant value
+ * @param op: comparison, one of DSPS_CMP_*
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cmp_s16_esp(const int16_t *x,\
+                           uint32_t *mask,\
+                           int len,\
+                           const int16_t *C,\
+                           int op,\
+                           int step_x = 1);
+
+/**
+ * @brief Compare every element of an array with a constant into a bitmask
+ *
+ * Bit i of the mask (bit i%32 of mask[i/32]) is set when x[i] op C holds.
+ * The bits of the last word past len are cleared, so the mask takes
+ * (len + 31)/32 words.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * 32 elements are compared (ee.vcmp.*) and packed into a mask word at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param mask: output bitmask
+ * @param len: amount of elements
+ * @param C: constant value
+ * @param op: comparison, one of DSPS_CMP_*
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cmp_s32_esp(const int32_t *x,\
+                           uint32_t *mask,\
+                           int len,\
+                           const int32_t C,\
+                           int op,\
+                           int step_x = 1);
+
+/**
+ * @brief Compare every element of an array with a constant into a bitmask
+ *
+ * Bit i of the mask (bit i%32 of mask[i/32]) is set when x[i] op C holds.
+ * The bits of the last word past len are cleared, so the mask takes
+ * (len + 31)/32 words.
+ * Comparisons follow IEEE 754: a NaN element only sets the DSPS_CMP_NE bit.
+ * PIE has no float comparison, so on ESP32 devices the elements are compared
+ * one at a time by the FPU.
+ *
+ * @param x: input array
+ * @param mask: output bitmask
+ * @param len: amount of elements
+ * @param C: constant value
+ * @param op: comparison, one of DSPS_CMP_*
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_cmp_f32_esp(const float *x,\
+                           uint32_t *mask,\
+                           int len,\
+                           const float C,\
+                           int op,\
+                           int step_x = 1);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_cmp_H_
@@ -0,0 +1,96 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_cmp_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/* x op c, on scalars (bool) as well as on vectors (0 or -1 lanes) */
+template<int OP, typename V>
+inline auto cmp(const V x, const V c) -> decltype(x == c)
+{
+  if (OP == DSPS_CMP_EQ) return x == c;
+  if (OP == DSPS_CMP_NE) return x != c;
+  if (OP == DSPS_CMP_LT) return x < c;
+  if (OP == DSPS_CMP_GE) return x >= c;
+  if (OP == DSPS_CMP_GT) return x > c;
+  return x <= c;
+}
+
+template<int OP, typename T, typename V>
+inline esp_err_t cmp_op(const T *x, uint32_t *mask, int len, const T C, int step_x)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1)
+  {
+    const V c = vbroadcast<V>(C);
+    for (; i + 32 <= len; i += 32)
+    {
+      uint32_t word = 0;
+      for (int k = 0; k < 32; k += DSPS_LANES(T))
+        word |= vmovemask(cmp<OP>(vload<V>(x + i + k), c)) << k;
+      mask[i/32] = word;
+    }
+  }
+#endif
+  uint32_t word = 0;
+  for (; i < len; i++)
+  {
+    word |= (uint32_t)cmp<OP>(x[i*step_x], C) << (i % 32);
+    if (i % 32 == 31)
+    {
+      mask[i/32] = word;
+      word = 0;
+    }
+  }
+  if (len % 32)
+    mask[len/32] = word;
+  return ESP_OK;
+}
+
+template<typename T, typename V>
+inline esp_err_t cmp_kernel(const T *x, uint32_t *mask, int len, const T C, int op, int step_x)
+{
+  switch (op)
+  {
+    case DSPS_CMP_EQ: return cmp_op<DSPS_CMP_EQ, T, V>(x, mask, len, C, step_x);
+    case DSPS_CMP_NE: return cmp_op<DSPS_CMP_NE, T, V>(x, mask, len, C, step_x);
+    case DSPS_CMP_LT: return cmp_op<DSPS_CMP_LT, T, V>(x, mask, len, C, step_x);
+    case DSPS_CMP_GE: return cmp_op<DSPS_CMP_GE, T, V>(x, mask, len, C, step_x);
+    case DSPS_CMP_GT: return cmp_op<DSPS_CMP_GT, T, V>(x, mask, len, C, step_x);
+    case DSPS_CMP_LE: return cmp_op<DSPS_CMP_LE, T, V>(x, mask, len, C, step_x);
+    default: return ESP_ERR_DSP_INVALID_PARAM;
+  }
+}
+
+#if !DSPS_HOST_SIMD
+/* Only the scalar loop is instantiated, V is never used */
+typedef int8_t v_s8;
+typedef int16_t v_s16;
+typedef int32_t v_s32;
+typedef float v_f32;
+#endif
+
+esp_err_t dsps_cmp_s8_esp(const int8_t *x, uint32_t *mask, int len, const int8_t *C, int op, int step_x)
+{
+  return cmp_kernel<int8_t, v_s8>(x, mask, len, *C, op, step_x);
+}
+
+esp_err_t dsps_cmp_s16_esp(const int16_t *x, uint32_t *mask, int len, const int16_t *C, int op, int step_x)
+{
+  return cmp_kernel<int16_t, v_s16>(x, mask, len, *C, op, step_x);
+}
+
+esp_err_t dsps_cmp_s32_esp(const int32_t *x, uint32_t *mask, int len, const int32_t C, int op, int step_x)
+{
+  return cmp_kernel<int32_t, v_s32>(x, mask, len, C, op, step_x);
+}
+
+esp_err_t dsps_cmp_f32_esp(const float *x, uint32_t *mask, int len, const float C, int op, int step_x)
+{
+  return cmp_kernel<float, v_f32>(x, mask, len, C, op, step_x);
+}
+
+#endif
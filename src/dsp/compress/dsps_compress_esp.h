@@ -0,0 +1,67 @@
+#ifndef _custom_dsps_compress_H_
+#define _custom_dsps_compress_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Stream compaction: copy the elements selected by a bitmask
+ *
+ * x[i] is copied to the next free position of y when bit i of the mask
+ * (bit i%32 of mask[i/32]) is set, so y receives as many elements as there
+ * are bits set, in order. The mask is walked a word at a time: empty words
+ * skip 32 elements, full words are copied without testing any bit.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param mask: bitmask of (len + 31)/32 words
+ * @param y: output array, as long as the number of bits set in the mask
+ * @param len: amount of elements of x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_compress_s16_esp(const int16_t *x,\
+                                const uint32_t *mask,\
+                                int16_t *y,\
+                                int len);
+
+/**
+ * @brief Stream compaction: copy the elements selected by a bitmask
+ *
+ * x[i] is copied to the next free position of y when bit i of the mask
+ * (bit i%32 of mask[i/32]) is set, so y receives as many elements as there
+ * are bits set, in order. The mask is walked a word at a time: empty words
+ * skip 32 elements, full words are copied without testing any bit.
+ * Elements are copied as they are, so it serves float arrays as well.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param mask: bitmask of (len + 31)/32 words
+ * @param y: output array, as long as the number of bits set in the mask
+ * @param len: amount of elements of x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_compress_s32_esp(const int32_t *x,\
+                                const uint32_t *mask,\
+                                int32_t *y,\
+                                int len);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_compress_H_
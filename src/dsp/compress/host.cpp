@@ -0,0 +1,39 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_compress_esp.h"
+#include "../dsps_host.h"
+
+template<typename T>
+inline void compress(const T *x, const uint32_t *mask, T *y, int len)
+{
+  for (int i = 0; i < len; i += 32)
+  {
+    uint32_t word = mask[i/32];
+    if (len - i < 32)
+      word &= ((uint32_t)1 << (len - i)) - 1;
+
+    if (word == UINT32_MAX)
+    {
+      memcpy(y, x + i, 32*sizeof(T));
+      y += 32;
+    }
+    else
+      for (; word; word &= word - 1)  /* one iteration per bit set */
+        *y++ = x[i + __builtin_ctz(word)];
+  }
+}
+
+esp_err_t dsps_compress_s16_esp(const int16_t *x, const uint32_t *mask, int16_t *y, int len)
+{
+  compress(x, mask, y, len);
+  return ESP_OK;
+}
+
+esp_err_t dsps_compress_s32_esp(const int32_t *x, const uint32_t *mask, int32_t *y, int len)
+{
+  compress(x, mask, y, len);
+  return ESP_OK;
+}
+
+#endif
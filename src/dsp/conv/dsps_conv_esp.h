@@ -0,0 +1,109 @@
+#ifndef _custom_dsps_conv_H_
+#define _custom_dsps_conv_H_
+#include "../../esp_platform.h"
+
+#if !ESP_MATH_HOST
+#include "dsps_conv.h"
+#include "dsps_corr.h"
+#include "dsps_dotprod.h"
+#else
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Convolution
+ *
+ * Host implementation of the esp-dsp function with the same name.
+ * convout[n] = sum(Signal[k]*Kernel[n-k]); n=[0..siglen+kernlen-1)
+ *
+ * @param Signal: input array
+ * @param siglen: length of the input array
+ * @param Kernel: kernel array
+ * @param kernlen: length of the kernel array
+ * @param convout: output array with siglen + kernlen - 1 elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_conv_f32_ae32(const float *Signal,\
+                             const int siglen,\
+                             const float *Kernel,\
+                             const int kernlen,\
+                             float *convout);
+
+/**
+ * @brief Correlation with pattern
+ *
+ * Host implementation of the esp-dsp function with the same name.
+ * dest[n] = sum(Signal[n+m]*Pattern[m]); n=[0..siglen-patlen]
+ *
+ * @param Signal: input array
+ * @param siglen: length of the input array
+ * @param Pattern: pattern array
+ * @param patlen: length of the pattern array
+ * @param dest: output array with siglen - patlen + 1 elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_corr_f32_ae32(const float *Signal,\
+                             const int siglen,\
+                             const float *Pattern,\
+                             const int patlen,\
+                             float *dest);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Correlation with pattern of fixed point arrays
+ *
+ * dest[n] = sat16(sum(Signal[n+m]*Pattern[m]) >> shift); n=[0..siglen-patlen]
+ * The products are accumulated without any loss (40 bits accumulator), shifted
+ * once and saturated to 16 bits. With shift as the fractional bits of the
+ * pattern, dest keeps the fixed point format of the signal.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * ee.vmulas.s16.accx over 8 pattern elements at a time. The signal may be
+ * unaligned (ee.ld.128.usar.ip / ee.src.q.qup).
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned patterns can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param Signal: input array
+ * @param siglen: length of the input array
+ * @param Pattern: pattern array
+ * @param patlen: length of the pattern array
+ * @param dest: output array with siglen - patlen + 1 elements
+ * @param shift: right shift applied to the accumulated products
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_DSP_PARAM_OUTOFRANGE if siglen < patlen
+ */
+esp_err_t dsps_corr_s16_esp(const int16_t *Signal,\
+                            const int siglen,\
+                            const int16_t *Pattern,\
+                            const int patlen,\
+                            int16_t *dest,\
+                            const int shift);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_conv_H_
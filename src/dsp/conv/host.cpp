@@ -0,0 +1,99 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_conv_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/**
+ * @brief y[i] += x[i]*c; i=[0..len)
+ */
+static inline void axpy_f32(const float *x, float *y, int len, const float c)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  const v_f32 c_v = vbroadcast<v_f32>(c);
+  for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+    vstore(y + i, vload<v_f32>(y + i) + vload<v_f32>(x + i) * c_v);
+#endif
+  for (; i < len; i++)
+    y[i] += x[i] * c;
+}
+
+/**
+ * @brief sum(x1[i]*x2[i]); i=[0..len)
+ */
+static inline float dotp_f32(const float *x1, const float *x2, int len)
+{
+  float acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  v_f32 acc_v = {};
+  for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+    acc_v += vload<v_f32>(x1 + i) * vload<v_f32>(x2 + i);
+  acc = vhsum<float>(acc_v);
+#endif
+  for (; i < len; i++)
+    acc += x1[i] * x2[i];
+  return acc;
+}
+
+/**
+ * @brief sum(x1[i]*x2[i]); i=[0..len), without any loss
+ */
+static inline int64_t dotp_s16(const int16_t *x1, const int16_t *x2, int len)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  v_s16q acc_v = {};
+  for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+  {
+    const v_s16w p = __builtin_convertvector(vload<v_s16>(x1 + i), v_s16w) * __builtin_convertvector(vload<v_s16>(x2 + i), v_s16w);
+    acc_v += __builtin_convertvector(p, v_s16q);
+  }
+  acc = vhsum<int64_t>(acc_v);
+#endif
+  for (; i < len; i++)
+    acc += (int32_t)x1[i] * x2[i];
+  return acc;
+}
+
+esp_err_t dsps_conv_f32_ae32(const float *Signal, const int siglen, const float *Kernel, const int kernlen, float *convout)
+{
+  if (NULL == Signal || NULL == Kernel || NULL == convout)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  /* Scatter form: every kernel tap adds a scaled copy of the signal, which vectorizes. */
+  memset(convout, 0, sizeof(float)*(siglen + kernlen - 1));
+  for (int k = 0; k < kernlen; k++)
+    axpy_f32(Signal, convout + k, siglen, Kernel[k]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_corr_f32_ae32(const float *Signal, const int siglen, const float *Pattern, const int patlen, float *dest)
+{
+  if (NULL == Signal || NULL == Pattern || NULL == dest)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+  if (siglen < patlen)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  for (int n = 0; n <= siglen - patlen; n++)
+    dest[n] = dotp_f32(Signal + n, Pattern, patlen);
+  return ESP_OK;
+}
+
+esp_err_t dsps_corr_s16_esp(const int16_t *Signal, const int siglen, const int16_t *Pattern, const int patlen, int16_t *dest, const int shift)
+{
+  if (NULL == Signal || NULL == Pattern || NULL == dest)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+  if (siglen < patlen)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  for (int n = 0; n <= siglen - patlen; n++)
+    dest[n] = sat16(sat32(dotp_s16(Signal + n, Pattern, patlen) >> shift));
+  return ESP_OK;
+}
+
+#endif
@@ -1,8 +1,13 @@
 #ifndef _custom_dsps_div_H_
 #define _custom_dsps_div_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
+#include "../fixed/dsps_fixed_mode.h"
+#include <math.h>
+#include <string.h>
 
+#if !ESP_MATH_HOST
 #include "dsps_mul_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -99,6 +104,12 @@ esp_err_t dsps_div_s32_esp(const int32_t *x1,\
  * y[i] = x1[i]*x2[i]; i=[0..len)
  * The implementation target ESP32 devices and it's optmized using DSP instructions.
  * 
+ * There is no division per element: the recip0.s seed of 1/x2[i] is refined
+ * by two Newton-Raphson steps and the quotient x1[i]*(1/x2[i]) is corrected
+ * once (see dsps_div_nr_f32). The result is within 2 ulp of x1[i] / x2[i]
+ * for normal divisors (|x2[i]| < 2^126) and quotients. Zero and infinite
+ * divisors, and quotients that overflow, give the IEEE results.
+ * 
  * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
  * If you are using espmath::Array, you don't have to worry about it.
  *
@@ -119,6 +130,117 @@ esp_err_t dsps_div_f32_esp(const float *x1,\
                            int step_x2 = 1,\
                            int step_y  = 1);
 
+/**
+ * @brief   divide fixed point arrays
+ *
+ * y[i] = (x1[i] << frac) / x2[i]; i=[0..len)
+ * The dividend is extended to 64 bits, so the division (__divdi3) does not
+ * lose the integer part of Q16.16 or Q31 arrays.
+ * 
+ * @param x1: input array
+ * @param x2: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param frac: Fractional part. For instance, if Q16.16, then frac = 16
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_div_fixed_s32_esp(const int32_t *x1,\
+                                 const int32_t *x2,\
+                                 int32_t *y,\
+                                 int len,\
+                                 int step_x1 = 1,\
+                                 int step_x2 = 1,\
+                                 int step_y = 1,\
+                                 int frac = 16);
+
+/**
+ * @brief   divide fixed point arrays, with a rounding and an overflow mode
+ *
+ * y[i] = (x1[i] << frac) / x2[i]; i=[0..len)
+ * The quotient is rounded and narrowed to 16 bits as mode says (see
+ * dsps_fixed_mode.h), in the same pass.
+ * 
+ * @param x1: input array
+ * @param x2: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param frac: Fractional part. For instance, if Q15, then frac = 15
+ * @param mode: DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT,
+ * or'ed with DSPS_FIXED_WRAP or DSPS_FIXED_SATURATE
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_div_s16_mode_esp(const int16_t *x1,\
+                                const int16_t *x2,\
+                                int16_t *y,\
+                                int len,\
+                                int step_x1 = 1,\
+                                int step_x2 = 1,\
+                                int step_y = 1,\
+                                int frac = 0,\
+                                int mode = DSPS_FIXED_TRUNCATE);
+
+/**
+ * @brief Seed of 1/d (recip0.s): about 4 bits right, infinite for a zero
+ * divisor, zero for an infinite one and NaN for a NaN one
+ */
+static inline float dsps_recip0_f32(const float d)
+{
+#if ESP_MATH_DSP && !ESP_MATH_HOST
+  float r;
+  __asm__("recip0.s %0, %1" : "=f"(r) : "f"(d));
+  return r;
+#else
+  uint32_t b;
+  memcpy(&b, &d, sizeof(b));
+  const uint32_t sign = b & 0x80000000u, mag = b & 0x7FFFFFFFu;
+  if (mag > 0x7F800000u)
+    return d;
+  b = mag == 0 ? 0x7F800000u | sign : (mag == 0x7F800000u ? sign : (0x7EF311C3u - mag) | sign);
+  float r;
+  memcpy(&r, &b, sizeof(r));
+  return r;
+#endif
+}
+
+/**
+ * @brief a + b*c, rounded once on the FPU (madd.s) as the kernels compute it.
+ * The host kernels round twice.
+ */
+static inline float dsps_madd_f32(const float a, const float b, const float c)
+{
+#if ESP_MATH_DSP && !ESP_MATH_HOST
+  return fmaf(b, c, a);
+#else
+  return a + b*c;
+#endif
+}
+
+/**
+ * @brief n/d as dsps_div_f32_esp and dsps_cdiv_f32_esp compute it
+ *
+ * The seed of 1/d is refined by two Newton-Raphson steps, then the quotient
+ * is corrected once. Zero and infinite divisors make the refinement NaN:
+ * the seed is kept instead, which gives n*inf and n*0. A correction that
+ * turns NaN (such divisors, quotients that overflow) is dropped, and so is
+ * the correction of a zero dividend, which would lose the sign of the zero.
+ */
+static inline float dsps_div_nr_f32(const float n, const float d)
+{
+  const float r0 = dsps_recip0_f32(d);
+  float r = dsps_madd_f32(r0, r0, dsps_madd_f32(1.0f, -d, r0));
+  r = dsps_madd_f32(r, r, dsps_madd_f32(1.0f, -d, r));
+  r = r != r ? r0 : r;
+  const float y = n*r;
+  const float q = dsps_madd_f32(y, r, dsps_madd_f32(n, -d, y));
+  return q != q || n == 0 ? y : q;
+}
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,77 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_div_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_div_s8_esp(const int8_t *x1, const int8_t *x2, int8_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(y + i, vdiv(vload<v_s8>(x1 + i), vload<v_s8>(x2 + i)));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = (int8_t)((int32_t)x1[i*step_x1] / x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_div_s16_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vdiv(vload<v_s16>(x1 + i), vload<v_s16>(x2 + i), frac));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = (int16_t)(((int32_t)x1[i*step_x1] << frac) / x2[i*step_x2]);
+  return ESP_OK;
+}
+
+/* Only wrapped and truncated quotients have a vector path, the others are rounded one at a time */
+esp_err_t dsps_div_s16_mode_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac, int mode)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (mode == (DSPS_FIXED_TRUNCATE | DSPS_FIXED_WRAP) && step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vdiv(vload<v_s16>(x1 + i), vload<v_s16>(x2 + i), frac));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = dsps_fixed_div_s16(x1[i*step_x1], x2[i*step_x2], frac, mode);
+  return ESP_OK;
+}
+
+/* There is no exact vector path for 32 bits integer division (quos on the device as well). */
+esp_err_t dsps_div_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  for (int i = 0; i < len; i++)
+    y[i*step_y] = x1[i*step_x1] / x2[i*step_x2];
+  return ESP_OK;
+}
+
+esp_err_t dsps_div_f32_esp(const float *x1, const float *x2, float *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(y + i, vdiv_nr(vload<v_f32>(x1 + i), vload<v_f32>(x2 + i)));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = dsps_div_nr_f32(x1[i*step_x1], x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_div_fixed_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int step_y, int frac)
+{
+  for (int i = 0; i < len; i++)
+    y[i*step_y] = (int32_t)(((int64_t)x1[i*step_x1] << frac) / x2[i*step_x2]);
+  return ESP_OK;
+}
+
+#endif
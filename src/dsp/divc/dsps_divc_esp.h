@@ -1,8 +1,11 @@
 #ifndef _custom_dsps_divc_H_
 #define _custom_dsps_divc_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
+#include "../fixed/dsps_fixed_mode.h"
 
+#if !ESP_MATH_HOST
 #include "dsps_addc_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -86,6 +89,14 @@ esp_err_t dsps_cdiv_s8_esp(const int8_t *input, int8_t *output, int len, const i
  * x[i] = y[i] / C; i=[0..len)
  * The implementation target ESP32 devices and it's optmized using DSP instructions.
  * 
+ * dsps_divc_f32_esp divides once, 1/C, and multiplies every element by the
+ * reciprocal: the result is within 1.5 ulp of y[i] / C.
+ * dsps_cdiv_f32_esp computes C / y[i] from a Newton-Raphson reciprocal
+ * (recip0.s seed, two refinement steps and one correction of the quotient,
+ * see dsps_div_nr_f32): within 2 ulp for normal divisors (|y[i]| < 2^126)
+ * and quotients, the IEEE results for zero and infinite y[i].
+ * Neither calls the soft-float division per element.
+ *
  * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
  * If you are using espmath::Array, you don't have to worry about it.
  *
@@ -101,6 +112,135 @@ esp_err_t dsps_cdiv_s8_esp(const int8_t *input, int8_t *output, int len, const i
 esp_err_t dsps_divc_f32_esp(const float *input, float *output, int len, const float C, int step_in = 1, int step_out = 1);
 esp_err_t dsps_cdiv_f32_esp(const float *input, float *output, int len, const float C, int step_in = 1, int step_out = 1);
 
+/**
+ * @brief Division by a constant turned into a multiplication (Hacker's Delight, 10-1)
+ *
+ * For 2 <= |C| < 2^31, every int32 n satisfies (C division truncates):
+ * q = (mulsh(n, multiplier) + (n & add)) >> shift, plus 1 when n < 0
+ * n / C = (q ^ negate) - negate
+ * multiplier and shift only depend on |C|, negate is -1 for a negative C.
+ */
+typedef struct
+{
+  int32_t multiplier;
+  int32_t add;      /* -1 when the multiplier went over 2^31 (it's then read as negative), 0 otherwise */
+  int32_t shift;
+  int32_t negate;   /* -1 for a negative divisor, 0 otherwise */
+} dsps_divc_magic_t;
+
+/**
+ * @brief Compute the magic numbers of a division by C
+ *
+ * @param C: divisor
+ * @param magic: magic numbers
+ *
+ * @return
+ *      - 1 on success
+ *      - 0 when |C| < 2 or C = INT32_MIN, which must be divided with quos
+ */
+static inline int dsps_divc_magic(const int32_t C, dsps_divc_magic_t *magic)
+{
+  if (C > -2 && C < 2)
+    return 0;
+  if (C == INT32_MIN)
+    return 0;
+  const uint32_t two31 = 0x80000000u;
+  const uint32_t ad = C < 0 ? (uint32_t)-C : (uint32_t)C;
+  const uint32_t anc = two31 - 1 - two31 % ad;  /* |nc|, the largest multiple of ad - 1 below 2^31 */
+  uint32_t q1 = two31 / anc, r1 = two31 - q1 * anc;
+  uint32_t q2 = two31 / ad, r2 = two31 - q2 * ad;
+  uint32_t delta;
+  int p = 31;
+  do
+  {
+    p++;
+    q1 = 2 * q1;
+    r1 = 2 * r1;
+    if (r1 >= anc)
+    {
+      q1++;
+      r1 -= anc;
+    }
+    q2 = 2 * q2;
+    r2 = 2 * r2;
+    if (r2 >= ad)
+    {
+      q2++;
+      r2 -= ad;
+    }
+    delta = ad - r2;
+  } while (q1 < delta || (q1 == delta && r1 == 0));
+  magic->multiplier = (int32_t)(q2 + 1);
+  magic->add = magic->multiplier < 0 ? -1 : 0;
+  magic->shift = p - 32;
+  magic->negate = C < 0 ? -1 : 0;
+  return 1;
+}
+
+/**
+ * @brief divide by constant, through its magic numbers
+ *
+ * x[i] = y[i] / C; i=[0..len), the same results as dsps_divc_*_esp
+ * The division is a high multiplication (mulsh) and a few shifts and
+ * additions per element, instead of quos.
+ * For int16_t, y[i] << frac is divided, as dsps_divc_s16_esp does.
+ *
+ * @param input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param magic: magic numbers of C, from dsps_divc_magic
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_divc_magic_s32_esp(const int32_t *input, int32_t *output, int len, const dsps_divc_magic_t *magic, int step_in = 1, int step_out = 1);
+esp_err_t dsps_divc_magic_s16_esp(const int16_t *input, int16_t *output, int len, const dsps_divc_magic_t *magic, int step_in = 1, int step_out = 1, int frac = 0);
+esp_err_t dsps_divc_magic_s8_esp(const int8_t *input, int8_t *output, int len, const dsps_divc_magic_t *magic, int step_in = 1, int step_out = 1);
+
+/**
+ * @brief divide fixed point array by constant, and constant by array
+ *
+ * dsps_divc_fixed_s32_esp: y[i] = (x[i] << frac) / C; i=[0..len)
+ * dsps_cdiv_fixed_s32_esp: y[i] = (C << frac) / x[i]; i=[0..len)
+ * The dividend is extended to 64 bits (__divdi3), as dsps_div_fixed_s32_esp does.
+ *
+ * @param input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param C: constant value
+ * @param frac: Fractional part. For instance, if Q16.16, then frac = 16
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_divc_fixed_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in = 1, int step_out = 1, int frac = 16);
+esp_err_t dsps_cdiv_fixed_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in = 1, int step_out = 1, int frac = 16);
+
+/**
+ * @brief divide fixed point array by constant, and constant by array, with a rounding and an overflow mode
+ *
+ * dsps_divc_s16_mode_esp: y[i] = (x[i] << frac) / C; i=[0..len)
+ * dsps_cdiv_s16_mode_esp: y[i] = (C << frac) / x[i]; i=[0..len)
+ * The quotient is rounded and narrowed to 16 bits as mode says (see
+ * dsps_fixed_mode.h), in the same pass.
+ *
+ * @param input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param C: constant value
+ * @param frac: Fractional part. For instance, if Q15, then frac = 15
+ * @param mode: DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT,
+ * or'ed with DSPS_FIXED_WRAP or DSPS_FIXED_SATURATE
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_divc_s16_mode_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in = 1, int step_out = 1, int frac = 0, int mode = DSPS_FIXED_TRUNCATE);
+esp_err_t dsps_cdiv_s16_mode_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in = 1, int step_out = 1, int frac = 0, int mode = DSPS_FIXED_TRUNCATE);
+
 /**@}*/
 
 #ifdef __cplusplus
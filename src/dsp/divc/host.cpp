@@ -0,0 +1,225 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_divc_esp.h"
+#include "../div/dsps_div_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/* There is no exact vector path for 32 bits integer division (quos on the device as well). */
+esp_err_t dsps_divc_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in, int step_out)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = input[i*step_in] / C;
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in, int step_out)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = C / input[i*step_in];
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_s16_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in, int step_out, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(output + i, vdiv(vload<v_s16>(input + i), c_v, frac));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int16_t)(((int32_t)input[i*step_in] << frac) / C);
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_s16_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in, int step_out, int frac)
+{
+  const int32_t c = (int32_t)C << frac;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(output + i, vdiv(c_v, vload<v_s16>(input + i), frac));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int16_t)(c / input[i*step_in]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_s16_mode_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in, int step_out, int frac, int mode)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = dsps_fixed_div_s16(input[i*step_in], C, frac, mode);
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_s16_mode_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_in, int step_out, int frac, int mode)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = dsps_fixed_div_s16(C, input[i*step_in], frac, mode);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t C, int step_in, int step_out)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_s8 c_v = vbroadcast<v_s8>(C);
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(output + i, vdiv(vload<v_s8>(input + i), c_v));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int8_t)(input[i*step_in] / C);
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t C, int step_in, int step_out)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_s8 c_v = vbroadcast<v_s8>(C);
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(output + i, vdiv(c_v, vload<v_s8>(input + i)));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int8_t)(C / input[i*step_in]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_f32_esp(const float *input, float *output, int len, const float C, int step_in, int step_out)
+{
+  const float r = 1.0f / C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_f32 r_v = vbroadcast<v_f32>(r);
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(output + i, vload<v_f32>(input + i) * r_v);
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = input[i*step_in] * r;
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_f32_esp(const float *input, float *output, int len, const float C, int step_in, int step_out)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+  {
+    const v_f32 c_v = vbroadcast<v_f32>(C);
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(output + i, vdiv_nr(c_v, vload<v_f32>(input + i)));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = dsps_div_nr_f32(C, input[i*step_in]);
+  return ESP_OK;
+}
+
+/**
+ * @brief n / C through the magic numbers of C
+ */
+static inline int32_t divc_magic(const int32_t n, const dsps_divc_magic_t *magic)
+{
+  int32_t q = (int32_t)(((int64_t)n * magic->multiplier) >> 32);
+  q += n & magic->add;
+  q >>= magic->shift;
+  q += (int32_t)((uint32_t)n >> 31);
+  return (q ^ magic->negate) - magic->negate;
+}
+
+#if DSPS_HOST_SIMD
+/**
+ * @brief divc_magic over every lane of n (int32 lanes), the high product
+ * taken on W (int64 lanes), narrowed to R
+ */
+template<typename R, typename V, typename W>
+static inline R vdivc_magic(const V& n, const dsps_divc_magic_t *magic)
+{
+  V q = __builtin_convertvector((__builtin_convertvector(n, W) * (int64_t)magic->multiplier) >> 32, V);
+  q += n & magic->add;
+  q >>= magic->shift;
+  q -= n >> 31;
+  return __builtin_convertvector((q ^ magic->negate) - magic->negate, R);
+}
+#endif
+
+esp_err_t dsps_divc_magic_s32_esp(const int32_t *input, int32_t *output, int len, const dsps_divc_magic_t *magic, int step_in, int step_out)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(output + i, vdivc_magic<v_s32, v_s32, v_s32w>(vload<v_s32>(input + i), magic));
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = divc_magic(input[i*step_in], magic);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_magic_s16_esp(const int16_t *input, int16_t *output, int len, const dsps_divc_magic_t *magic, int step_in, int step_out, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+    {
+      const v_s16w n = __builtin_convertvector(vload<v_s16>(input + i), v_s16w) << frac;
+      vstore(output + i, vdivc_magic<v_s16, v_s16w, v_s16q>(n, magic));
+    }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int16_t)divc_magic((int32_t)input[i*step_in] << frac, magic);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_magic_s8_esp(const int8_t *input, int8_t *output, int len, const dsps_divc_magic_t *magic, int step_in, int step_out)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_in == 1 && step_out == 1)
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+    {
+      const v_s8q n = __builtin_convertvector(vload<v_s8>(input + i), v_s8q);
+      vstore(output + i, vdivc_magic<v_s8, v_s8q, v_s8o>(n, magic));
+    }
+#endif
+  for (; i < len; i++)
+    output[i*step_out] = (int8_t)divc_magic(input[i*step_in], magic);
+  return ESP_OK;
+}
+
+esp_err_t dsps_divc_fixed_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in, int step_out, int frac)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = (int32_t)(((int64_t)input[i*step_in] << frac) / C);
+  return ESP_OK;
+}
+
+esp_err_t dsps_cdiv_fixed_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_in, int step_out, int frac)
+{
+  const int64_t c = (int64_t)C << frac;
+  for (int i = 0; i < len; i++)
+    output[i*step_out] = (int32_t)(c / input[i*step_in]);
+  return ESP_OK;
+}
+
+#endif
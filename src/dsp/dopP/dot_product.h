@@ -1,8 +1,6 @@
 #ifndef _custom_dsps_dotp_H_
 #define _custom_dsps_dotp_H_
-#include "dsp_err.h"
-#include "../mul/dsps_mul_esp.h"
-#include "../sum/dsps_vsum_esp.h"
+#include "../../esp_platform.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -36,16 +34,49 @@ esp_err_t dsps_dotp_s16_esp(const int16_t *x1,\
                             int step_x2 = 1,\
                             int frac = 0);
 
+/**
+ * @brief Dot Produt between arrays, on a wide accumulator
+ *
+ * Unlike dsps_dotp_s16_esp, the products are neither shifted nor saturated
+ * while they are accumulated: the sum is kept on 40 bits (ACCX and ACC on
+ * ESP32-S3, 64 bits on host), shifted right by frac once and saturated to 32 bits.
+ * Long fixed point vectors do not overflow on the way.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x1: input array
+ * @param x2: input array
+ * @param y: output result
+ * @param len: amount of operations for arrays
+ * @param step_x1: step for input x1
+ * @param step_x2: step for input x2
+ * @param frac: Right shift of the sum. Inputs in Q(frac) give a Q(frac) result.
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dotpw_s16_esp(const int16_t *x1,\
+                             const int16_t *x2,\
+                             int32_t *y,\
+                             int len,\
+                             int step_x1 = 1,\
+                             int step_x2 = 1,\
+                             int frac = 0);
+
 /**
  * @brief   Dot Produt between arrays
  *
+ * The products are accumulated in a single pass on a wide accumulator
+ * (ACCX on ESP32-S3), so the result is exact for any practical length.
  * 
  * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
  * If you are using espmath::Array, you don't have to worry about it.
  *
  * @param x1: input array
  * @param x2: input array
- * @param y: output result
+ * @param y: output result, saturated to 32 bits
  * @param len: amount of operations for arrays
  * @param step_x1: step for input x1
  * @param step_x2: step for input x2
@@ -54,22 +85,18 @@ esp_err_t dsps_dotp_s16_esp(const int16_t *x1,\
  *      - ESP_OK on success
  *      - One of the error codes from DSP library
  */
-inline esp_err_t dsps_dotp_s8_esp(const int8_t *x1,\
-                                  const int8_t *x2,\
-                                  int8_t *y,\
-                                  int len,\
-                                  int step_x1 = 1,\
-                                  int step_x2 = 1)
-{
-  int8_t helper[len];
-  dsps_mul_s8_esp(x1, x2, helper, len, step_x1, step_x2, 1);
-  dsps_vsum_s8_esp(helper, y, len, 1);
-  return ESP_OK;
-}
+esp_err_t dsps_dotp_s8_esp(const int8_t *x1,\
+                           const int8_t *x2,\
+                           int32_t *y,\
+                           int len,\
+                           int step_x1 = 1,\
+                           int step_x2 = 1);
 
 /**
  * @brief Dot Product between arrays
  *
+ * The products are accumulated in a single pass on 64 bits, then the sum
+ * is shifted right by frac and saturated to 32 bits.
  * 
  * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
  * If you are using espmath::Array, you don't have to worry about it.
@@ -80,24 +107,19 @@ inline esp_err_t dsps_dotp_s8_esp(const int8_t *x1,\
  * @param len: amount of operations for arrays
  * @param step_x1: step for input x1
  * @param step_x2: step for input x2
+ * @param frac: Right shift of the sum (by default 0)
  *
  * @return
  *      - ESP_OK on success
  *      - One of the error codes from DSP library
  */
-inline esp_err_t dsps_dotp_s32_esp(const int32_t *x1,\
-                                  const int32_t *x2,\
-                                  int32_t *y,\
-                                  int len,\
-                                  int step_x1 = 1,\
-                                  int step_x2 = 1,\
-                                  int frac = 0)
-{
-  int32_t helper[len];
-  dsps_mul_s32_esp(x1, x2, helper, len, step_x1, step_x2, 1);
-  dsps_vsum_s32_esp(helper, y, len, 1);
-  return ESP_OK;
-}
+esp_err_t dsps_dotp_s32_esp(const int32_t *x1,\
+                            const int32_t *x2,\
+                            int32_t *y,\
+                            int len,\
+                            int step_x1 = 1,\
+                            int step_x2 = 1,\
+                            int frac = 0);
 
 /**
  * @brief Dot Product between arrays
@@ -124,6 +146,48 @@ esp_err_t dsps_dotp_f32_esp(const float *x1,\
                                   int step_x1 = 1,\
                                   int step_x2 = 1);
 
+/**
+ * @brief Dot Product between arrays, added to a 64 bits sum
+ *
+ * *y += sum(x1[i]*x2[i]); i=[0..len)
+ * Neither shifted nor saturated, so that a long dot product can be computed
+ * chunk by chunk (one short critical section each) and shifted and saturated
+ * once, with the result of a single dsps_dotp_s8_esp, dsps_dotpw_s16_esp or
+ * dsps_dotp_s32_esp call.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ * @param x1: input array
+ * @param x2: input array
+ * @param y: sum the dot product is added to
+ * @param len: amount of operations for arrays
+ * @param step_x1: step for input x1
+ * @param step_x2: step for input x2
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_dotp_s8_acc_esp(const int8_t *x1,\
+                               const int8_t *x2,\
+                               int64_t *y,\
+                               int len,\
+                               int step_x1 = 1,\
+                               int step_x2 = 1);
+
+esp_err_t dsps_dotpw_s16_acc_esp(const int16_t *x1,\
+                                 const int16_t *x2,\
+                                 int64_t *y,\
+                                 int len,\
+                                 int step_x1 = 1,\
+                                 int step_x2 = 1);
+
+esp_err_t dsps_dotp_s32_acc_esp(const int32_t *x1,\
+                                const int32_t *x2,\
+                                int64_t *y,\
+                                int len,\
+                                int step_x1 = 1,\
+                                int step_x2 = 1);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,169 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dot_product.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_dotp_s16_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int frac)
+{
+  int32_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_s16w acc_v = {};
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+    {
+      const v_s16w p = __builtin_convertvector(vload<v_s16>(x1 + i), v_s16w) * __builtin_convertvector(vload<v_s16>(x2 + i), v_s16w);
+      acc_v += p >> frac;
+    }
+    acc = vhsum<int32_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += ((int32_t)x1[i*step_x1] * x2[i*step_x2]) >> frac;
+  *y = (int16_t)acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotpw_s16_esp(const int16_t *x1, const int16_t *x2, int32_t *y, int len, int step_x1, int step_x2, int frac)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_s16q acc_v = {};
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+    {
+      const v_s16w p = __builtin_convertvector(vload<v_s16>(x1 + i), v_s16w) * __builtin_convertvector(vload<v_s16>(x2 + i), v_s16w);
+      acc_v += __builtin_convertvector(p, v_s16q);
+    }
+    acc = vhsum<int64_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += (int32_t)x1[i*step_x1] * x2[i*step_x2];
+  *y = sat32(acc >> frac);
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotp_s8_esp(const int8_t *x1, const int8_t *x2, int32_t *y, int len, int step_x1, int step_x2)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    /* Every lane takes at most 2^14 per vector: flush the int32 lanes before they can overflow */
+    const int block = DSPS_LANES(int8_t) << 16;
+    while (i + DSPS_LANES(int8_t) <= len)
+    {
+      const int end = len - i > block ? i + block : len;
+      v_s8q acc_v = {};
+      for (; i + DSPS_LANES(int8_t) <= end; i += DSPS_LANES(int8_t))
+      {
+        const v_s8w p = __builtin_convertvector(vload<v_s8>(x1 + i), v_s8w) * __builtin_convertvector(vload<v_s8>(x2 + i), v_s8w);
+        acc_v += __builtin_convertvector(p, v_s8q);
+      }
+      acc += vhsum<int64_t>(acc_v);
+    }
+  }
+#endif
+  for (; i < len; i++)
+    acc += (int32_t)x1[i*step_x1] * x2[i*step_x2];
+  *y = sat32(acc);
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotp_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int frac)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_s32w acc_v = {};
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      acc_v += __builtin_convertvector(vload<v_s32>(x1 + i), v_s32w) * __builtin_convertvector(vload<v_s32>(x2 + i), v_s32w);
+    acc = vhsum<int64_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += (int64_t)x1[i*step_x1] * x2[i*step_x2];
+  *y = sat32(acc >> frac);
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotp_f32_esp(const float *x1, const float *x2, float *y, int len, int step_x1, int step_x2)
+{
+  float acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_f32 acc_v = {};
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      acc_v += vload<v_f32>(x1 + i) * vload<v_f32>(x2 + i);
+    acc = vhsum<float>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += x1[i*step_x1] * x2[i*step_x2];
+  *y = acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotp_s8_acc_esp(const int8_t *x1, const int8_t *x2, int64_t *y, int len, int step_x1, int step_x2)
+{
+  int64_t acc = 0;
+  for (int i = 0; i < len; i++)
+    acc += (int32_t)x1[i*step_x1] * x2[i*step_x2];
+  *y += acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotpw_s16_acc_esp(const int16_t *x1, const int16_t *x2, int64_t *y, int len, int step_x1, int step_x2)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_s16q acc_v = {};
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+    {
+      const v_s16w p = __builtin_convertvector(vload<v_s16>(x1 + i), v_s16w) * __builtin_convertvector(vload<v_s16>(x2 + i), v_s16w);
+      acc_v += __builtin_convertvector(p, v_s16q);
+    }
+    acc = vhsum<int64_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += (int32_t)x1[i*step_x1] * x2[i*step_x2];
+  *y += acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_dotp_s32_acc_esp(const int32_t *x1, const int32_t *x2, int64_t *y, int len, int step_x1, int step_x2)
+{
+  int64_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1)
+  {
+    v_s32w acc_v = {};
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      acc_v += __builtin_convertvector(vload<v_s32>(x1 + i), v_s32w) * __builtin_convertvector(vload<v_s32>(x2 + i), v_s32w);
+    acc = vhsum<int64_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += (int64_t)x1[i*step_x1] * x2[i*step_x2];
+  *y += acc;
+  return ESP_OK;
+}
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef _custom_dsps_host_H_
+#define _custom_dsps_host_H_
+
+/**
+ * @brief Helpers shared by the portable (host) implementation of the dsps_* kernels.
+ *
+ * The host kernels follow the results of the PIE vector path:
+ * int8 and int16 additions and subtractions saturate, int16 results are
+ * arithmetically shifted right by frac, int32 arithmetic wraps around.
+ *
+ * When the compiler supports GCC vector extensions (GCC >= 9, Clang), the
+ * kernels process DSPS_HOST_VECTOR_BYTES at a time whenever every step is 1,
+ * as the PIE kernels do. The vector width is selected at compile time:
+ * 32 bytes with AVX2, 16 bytes with SSE2 or NEON (or any other target,
+ * lowered by the compiler). Saturating int8/int16 arithmetic maps onto the
+ * native instructions of each instruction set.
+ * Define DSPS_HOST_SIMD to 0 to force the scalar kernels.
+ */
+
+#include "../esp_platform.h"
+#include "fixed/dsps_fixed_mode.h"
+
+#ifndef DSPS_HOST_SIMD
+#if defined(__GNUC__) && (defined(__clang__) || __GNUC__ >= 9)
+#define DSPS_HOST_SIMD 1
+#else
+#define DSPS_HOST_SIMD 0
+#endif
+#endif
+
+#if DSPS_HOST_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DSPS_HOST_VECTOR_BYTES 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define DSPS_HOST_VECTOR_BYTES 16
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DSPS_HOST_VECTOR_BYTES 16
+#else
+#define DSPS_HOST_VECTOR_BYTES 16
+#endif
+
+/**
+ * @brief Number of T lanes in a vector register
+ */
+#define DSPS_LANES(T) ((int)(DSPS_HOST_VECTOR_BYTES/sizeof(T)))
+#endif
+
+namespace espmath{
+namespace host{
+
+  inline int8_t sat8(int32_t value)
+  {
+    return (int8_t)(value > INT8_MAX ? INT8_MAX : (value < INT8_MIN ? INT8_MIN : value));
+  }
+
+  inline int16_t sat16(int32_t value)
+  {
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  }
+
+  inline int32_t sat32(int64_t value)
+  {
+    return (int32_t)(value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : value));
+  }
+
+  /* int32 arithmetic that wraps around as the Xtensa ALU does */
+  inline int32_t wadd32(int32_t a, int32_t b){return (int32_t)((uint32_t)a + (uint32_t)b);}
+  inline int32_t wsub32(int32_t a, int32_t b){return (int32_t)((uint32_t)a - (uint32_t)b);}
+  inline int32_t wmul32(int32_t a, int32_t b){return (int32_t)((uint32_t)a * (uint32_t)b);}
+
+#if DSPS_HOST_SIMD
+  typedef int8_t  v_s8  __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef uint8_t v_u8  __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef int16_t v_s16 __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef uint16_t v_u16 __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef int32_t v_s32 __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef uint32_t v_u32 __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+  typedef float   v_f32 __attribute__((vector_size(DSPS_HOST_VECTOR_BYTES)));
+
+  /* Same lane count as v_s8 / v_s16 / v_s32, two (or four) times as wide. Only used inside a function. */
+  typedef int16_t v_s8w  __attribute__((vector_size(2*DSPS_HOST_VECTOR_BYTES)));
+  typedef int32_t v_s16w __attribute__((vector_size(2*DSPS_HOST_VECTOR_BYTES)));
+  typedef int32_t v_s8q  __attribute__((vector_size(4*DSPS_HOST_VECTOR_BYTES)));
+  typedef int64_t v_s16q __attribute__((vector_size(4*DSPS_HOST_VECTOR_BYTES)));
+  typedef int64_t v_s32w __attribute__((vector_size(2*DSPS_HOST_VECTOR_BYTES)));
+  typedef int64_t v_s8o  __attribute__((vector_size(8*DSPS_HOST_VECTOR_BYTES)));
+  typedef float   v_s8f  __attribute__((vector_size(4*DSPS_HOST_VECTOR_BYTES)));
+  typedef double  v_s16d __attribute__((vector_size(4*DSPS_HOST_VECTOR_BYTES)));
+
+  template<typename V, typename T>
+  inline V vload(const T* src)
+  {
+    V v;
+    memcpy(&v, src, sizeof(V));
+    return v;
+  }
+
+  template<typename V, typename T>
+  inline void vstore(T* dest, const V v)
+  {
+    memcpy(dest, &v, sizeof(V));
+  }
+
+  template<typename V, typename T>
+  inline V vbroadcast(const T value)
+  {
+    V v;
+    for (size_t i = 0; i < sizeof(V)/sizeof(T); i++)
+      v[i] = value;
+    return v;
+  }
+
+  /**
+   * @brief Sum of every lane, accumulated as T
+   */
+  template<typename T, typename V>
+  inline T vhsum(const V& v)
+  {
+    T acc = 0;
+    for (size_t i = 0; i < sizeof(V)/sizeof(v[0]); i++)
+      acc += v[i];
+    return acc;
+  }
+
+  inline v_s8 vclamp8(const v_s8w& v)
+  {
+    v_s8w r = v;
+    r = r > (int16_t)INT8_MAX ? INT8_MAX : r;
+    r = r < (int16_t)INT8_MIN ? INT8_MIN : r;
+    return __builtin_convertvector(r, v_s8);
+  }
+
+  inline v_s16 vclamp16(const v_s16w& v)
+  {
+    v_s16w r = v;
+    r = r > (int32_t)INT16_MAX ? INT16_MAX : r;
+    r = r < (int32_t)INT16_MIN ? INT16_MIN : r;
+    return __builtin_convertvector(r, v_s16);
+  }
+
+  /* Saturating int8/int16 arithmetic */
+
+  inline v_s8 vadds(const v_s8 a, const v_s8 b)
+  {
+#if defined(__AVX2__)
+    return (v_s8)_mm256_adds_epi8((__m256i)a, (__m256i)b);
+#elif defined(__SSE2__)
+    return (v_s8)_mm_adds_epi8((__m128i)a, (__m128i)b);
+#elif defined(__ARM_NEON)
+    return (v_s8)vqaddq_s8((int8x16_t)a, (int8x16_t)b);
+#else
+    return vclamp8(__builtin_convertvector(a, v_s8w) + __builtin_convertvector(b, v_s8w));
+#endif
+  }
+
+  inline v_s8 vsubs(const v_s8 a, const v_s8 b)
+  {
+#if defined(__AVX2__)
+    return (v_s8)_mm256_subs_epi8((__m256i)a, (__m256i)b);
+#elif defined(__SSE2__)
+    return (v_s8)_mm_subs_epi8((__m128i)a, (__m128i)b);
+#elif defined(__ARM_NEON)
+    return (v_s8)vqsubq_s8((int8x16_t)a, (int8x16_t)b);
+#else
+    return vclamp8(__builtin_convertvector(a, v_s8w) - __builtin_convertvector(b, v_s8w));
+#endif
+  }
+
+  inline v_s16 vadds(const v_s16 a, const v_s16 b)
+  {
+#if defined(__AVX2__)
+    return (v_s16)_mm256_adds_epi16((__m256i)a, (__m256i)b);
+#elif defined(__SSE2__)
+    return (v_s16)_mm_adds_epi16((__m128i)a, (__m128i)b);
+#elif defined(__ARM_NEON)
+    return (v_s16)vqaddq_s16((int16x8_t)a, (int16x8_t)b);
+#else
+    return vclamp16(__builtin_convertvector(a, v_s16w) + __builtin_convertvector(b, v_s16w));
+#endif
+  }
+
+  inline v_s16 vsubs(const v_s16 a, const v_s16 b)
+  {
+#if defined(__AVX2__)
+    return (v_s16)_mm256_subs_epi16((__m256i)a, (__m256i)b);
+#elif defined(__SSE2__)
+    return (v_s16)_mm_subs_epi16((__m128i)a, (__m128i)b);
+#elif defined(__ARM_NEON)
+    return (v_s16)vqsubq_s16((int16x8_t)a, (int16x8_t)b);
+#else
+    return vclamp16(__builtin_convertvector(a, v_s16w) - __builtin_convertvector(b, v_s16w));
+#endif
+  }
+
+  /**
+   * @brief (a*b) >> frac computed on 32 bits, truncated to 16 bits (ee.vmul.s16)
+   */
+  inline v_s16 vmul(const v_s16 a, const v_s16 b, const int frac)
+  {
+    const v_s16w p = __builtin_convertvector(a, v_s16w) * __builtin_convertvector(b, v_s16w);
+    return __builtin_convertvector(p >> frac, v_s16);
+  }
+
+  /**
+   * @brief (a*b) >> frac computed on 32 bits, saturated to 16 bits (ee.vsmulas.s16.qacc + ee.srcmb.s16.qacc)
+   */
+  inline v_s16 vmuls(const v_s16 a, const v_s16 b, const int frac)
+  {
+    const v_s16w p = __builtin_convertvector(a, v_s16w) * __builtin_convertvector(b, v_s16w);
+    return vclamp16(p >> frac);
+  }
+
+  /**
+   * @brief (a*b) >> frac computed on 32 bits, rounded and narrowed as mode
+   * says (dsps_fixed_mul_s16 over every lane)
+   */
+  inline v_s16 vmul(const v_s16 a, const v_s16 b, const int frac, const int mode)
+  {
+    v_s16w p = __builtin_convertvector(a, v_s16w) * __builtin_convertvector(b, v_s16w);
+    const int rounding = frac ? (mode & DSPS_FIXED_ROUNDING) : DSPS_FIXED_TRUNCATE;
+    if (rounding == DSPS_FIXED_NEAREST)
+      p += (int32_t)1 << (frac - 1);
+    else if (rounding == DSPS_FIXED_CONVERGENT)
+      p += ((int32_t)1 << (frac - 1)) - 1 + ((p >> frac) & 1);
+    p >>= frac;
+    return mode & DSPS_FIXED_SATURATE ? vclamp16(p) : __builtin_convertvector(p, v_s16);
+  }
+
+  /**
+   * @brief Truncated int8 division through float lanes.
+   *
+   * Exact: the quotient is either an integer (exact in float) or at least
+   * 1/128 away from one, far more than the float rounding error.
+   */
+  inline v_s8 vdiv(const v_s8 a, const v_s8 b)
+  {
+    const v_s8f q = __builtin_convertvector(a, v_s8f) / __builtin_convertvector(b, v_s8f);
+    return __builtin_convertvector(__builtin_convertvector(q, v_s8w), v_s8);
+  }
+
+  /**
+   * @brief Truncated (a << frac) / b through double lanes.
+   *
+   * Exact: |a << frac| < 2^31 and |b| < 2^15, so a non integer quotient is
+   * at least 2^-15 away from an integer while the double rounding error is below 2^-22.
+   */
+  inline v_s16 vdiv(const v_s16 a, const v_s16 b, const int frac)
+  {
+    const v_s16d q = __builtin_convertvector(__builtin_convertvector(a, v_s16w) << frac, v_s16d) / __builtin_convertvector(b, v_s16d);
+    return __builtin_convertvector(__builtin_convertvector(q, v_s16w), v_s16);
+  }
+
+  /**
+   * @brief dsps_div_nr_f32 over every lane
+   */
+  inline v_f32 vdiv_nr(const v_f32 n, const v_f32 d)
+  {
+    const v_s32 b = (v_s32)d;
+    const v_s32 sign = b & (int32_t)0x80000000, mag = b & 0x7FFFFFFF;
+    v_s32 rb = (0x7EF311C3 - mag) | sign;
+    rb = mag == 0 ? (0x7F800000 | sign) : rb;
+    rb = mag == 0x7F800000 ? sign : rb;
+    rb = mag > 0x7F800000 ? b : rb;
+    const v_f32 r0 = (v_f32)rb;
+    v_f32 r = r0 + r0*(1.0f - d*r0);
+    r = r + r*(1.0f - d*r);
+    r = r != r ? r0 : r;
+    const v_f32 y = n*r;
+    const v_f32 q = y + r*(n - d*y);
+    return (q != q) | (n == 0) ? y : q;
+  }
+
+  /**
+   * @brief Round to nearest (ties to even) and convert to int32
+   */
+  inline v_s32 vround(const v_f32 v)
+  {
+#if defined(__AVX2__)
+    return (v_s32)_mm256_cvtps_epi32((__m256)v);
+#elif defined(__SSE2__)
+    return (v_s32)_mm_cvtps_epi32((__m128)v);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    return (v_s32)vcvtnq_s32_f32((float32x4_t)v);
+#else
+    v_s32 r;
+    for (int i = 0; i < DSPS_LANES(float); i++)
+      r[i] = (int32_t)lrintf(v[i]);
+    return r;
+#endif
+  }
+
+  /**
+   * @brief Pack the lanes of a comparison result (0 or -1) into the low bits
+   * of an integer, lane i into bit i (movemask)
+   */
+  inline uint32_t vmovemask(const v_s8 v)
+  {
+#if defined(__AVX2__)
+    return (uint32_t)_mm256_movemask_epi8((__m256i)v);
+#elif defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8((__m128i)v);
+#else
+    uint32_t bits = 0;
+    for (int i = 0; i < DSPS_LANES(int8_t); i++)
+      bits |= (uint32_t)(v[i] & 1) << i;
+    return bits;
+#endif
+  }
+
+  inline uint32_t vmovemask(const v_s16 v)
+  {
+#if defined(__AVX2__)
+    /* packs works on each 128 bits half: lanes 0-7 land in bits 0-7, lanes 8-15 in bits 16-23 */
+    const uint32_t bits = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16((__m256i)v, _mm256_setzero_si256()));
+    return (bits & 0xFF) | ((bits >> 8) & 0xFF00);
+#elif defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_packs_epi16((__m128i)v, _mm_setzero_si128()));
+#else
+    uint32_t bits = 0;
+    for (int i = 0; i < DSPS_LANES(int16_t); i++)
+      bits |= (uint32_t)(v[i] & 1) << i;
+    return bits;
+#endif
+  }
+
+  inline uint32_t vmovemask(const v_s32 v)
+  {
+#if defined(__AVX2__)
+    return (uint32_t)_mm256_movemask_ps((__m256)v);
+#elif defined(__SSE2__)
+    return (uint32_t)_mm_movemask_ps((__m128)v);
+#else
+    uint32_t bits = 0;
+    for (int i = 0; i < DSPS_LANES(int32_t); i++)
+      bits |= (uint32_t)(v[i] & 1) << i;
+    return bits;
+#endif
+  }
+#endif
+}
+}
+
+#endif // _dsps_host_H_
@@ -0,0 +1,63 @@
+#ifndef _custom_dsps_fft_H_
+#define _custom_dsps_fft_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Radix-4 butterflies of an in place complex FFT
+ *
+ * data holds n complex values (re, im) in bit reversed order and receives
+ * their DFT in natural order: X[m] = sum(x[i]*W^(i*m)), W = exp(-2*pi*j/n).
+ * When log2(n) is odd, a radix-2 pass (without twiddles) comes first, every
+ * other pass is a radix-4 one (3 complex products per 4 points).
+ * On ESP32 devices the butterflies run on the FPU, with the twiddles of a
+ * butterfly held in registers across all the groups that use them.
+ *
+ * @param data: n complex values, in bit reversed order
+ * @param n: amount of complex values, a power of 2
+ * @param tw: twiddles, tw[2i] = cos(2*pi*i/n), tw[2i + 1] = -sin(2*pi*i/n),
+ * i=[0..max(1, 3n/4))
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft4r_f32_esp(float *data,\
+                             int n,\
+                             const float *tw);
+
+/**
+ * @brief Radix-4 butterflies of an in place complex FFT, for Q15 values
+ *
+ * Same transform as dsps_fft4r_f32_esp, scaled by 1/n so it never overflows:
+ * the radix-2 pass halves its outputs and every radix-4 pass divides them by
+ * 4 (saturated). The output keeps the fixed point format of the input.
+ * The twiddles are Q15 and the products are truncated back to 16 bits.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * the twiddles are held in the MAC16 registers (mul.da/mula.da/muls.da) and
+ * a complex value is loaded with a single 32 bits access.
+ *
+ * @param data: n complex values, in bit reversed order
+ * @param n: amount of complex values, a power of 2
+ * @param tw: Q15 twiddles, tw[2i] = cos(2*pi*i/n), tw[2i + 1] = -sin(2*pi*i/n),
+ * i=[0..max(1, 3n/4))
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fft4r_s16_esp(int16_t *data,\
+                             int n,\
+                             const int16_t *tw);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fft_H_
@@ -0,0 +1,115 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_fft_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/*
+ * The device kernels walk the twiddles of a butterfly (k) in the outer loop
+ * and the groups that use them in the inner one; the host kernels keep the
+ * same order so both round the same way.
+ */
+
+esp_err_t dsps_fft4r_f32_esp(float *data, int n, const float *tw)
+{
+  if (NULL == data || NULL == tw)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+  if (n <= 0 || (n & (n - 1)))
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  int h = 1; /* quarter of the butterfly span */
+  if (__builtin_ctz(n) & 1)
+  {
+    for (int i = 0; i < 2*n; i += 4)
+    {
+      const float ar = data[i], ai = data[i + 1], br = data[i + 2], bi = data[i + 3];
+      data[i] = ar + br;
+      data[i + 1] = ai + bi;
+      data[i + 2] = ar - br;
+      data[i + 3] = ai - bi;
+    }
+    h = 2;
+  }
+  for (int groups = n/(4*h); groups; h *= 4, groups /= 4)
+    for (int k = 0; k < h; k++)
+    {
+      const float *w1 = tw + 2*k*groups, *w2 = tw + 4*k*groups, *w3 = tw + 6*k*groups;
+      for (float *p = data + 2*k; p < data + 2*n; p += 8*h)
+      {
+        float *p1 = p + 2*h, *p2 = p + 4*h, *p3 = p + 6*h;
+        const float br = w2[0]*p1[0] - w2[1]*p1[1], bi = w2[0]*p1[1] + w2[1]*p1[0];
+        const float cr = w1[0]*p2[0] - w1[1]*p2[1], ci = w1[0]*p2[1] + w1[1]*p2[0];
+        const float dr = w3[0]*p3[0] - w3[1]*p3[1], di = w3[0]*p3[1] + w3[1]*p3[0];
+        const float t0r = p[0] + br, t0i = p[1] + bi, t1r = p[0] - br, t1i = p[1] - bi;
+        const float t2r = cr + dr, t2i = ci + di, t3r = ci - di, t3i = dr - cr; /* t3 = -j(c - d) */
+        p[0] = t0r + t2r;
+        p[1] = t0i + t2i;
+        p2[0] = t0r - t2r;
+        p2[1] = t0i - t2i;
+        p1[0] = t1r + t3r;
+        p1[1] = t1i + t3i;
+        p3[0] = t1r - t3r;
+        p3[1] = t1i - t3i;
+      }
+    }
+  return ESP_OK;
+}
+
+/**
+ * @brief (w*x) >> 15, each part truncated
+ */
+static inline void cmul_s16(const int16_t *w, const int16_t *x, int32_t &re, int32_t &im)
+{
+  re = (int32_t)(((int64_t)w[0]*x[0] - (int64_t)w[1]*x[1]) >> 15);
+  im = (int32_t)(((int64_t)w[0]*x[1] + (int64_t)w[1]*x[0]) >> 15);
+}
+
+esp_err_t dsps_fft4r_s16_esp(int16_t *data, int n, const int16_t *tw)
+{
+  if (NULL == data || NULL == tw)
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+  if (n <= 0 || (n & (n - 1)))
+    return ESP_ERR_DSP_PARAM_OUTOFRANGE;
+
+  int h = 1; /* quarter of the butterfly span */
+  if (__builtin_ctz(n) & 1)
+  {
+    for (int i = 0; i < 2*n; i += 4)
+    {
+      const int32_t ar = data[i], ai = data[i + 1], br = data[i + 2], bi = data[i + 3];
+      data[i] = (ar + br) >> 1;
+      data[i + 1] = (ai + bi) >> 1;
+      data[i + 2] = (ar - br) >> 1;
+      data[i + 3] = (ai - bi) >> 1;
+    }
+    h = 2;
+  }
+  for (int groups = n/(4*h); groups; h *= 4, groups /= 4)
+    for (int k = 0; k < h; k++)
+    {
+      const int16_t *w1 = tw + 2*k*groups, *w2 = tw + 4*k*groups, *w3 = tw + 6*k*groups;
+      for (int16_t *p = data + 2*k; p < data + 2*n; p += 8*h)
+      {
+        int16_t *p1 = p + 2*h, *p2 = p + 4*h, *p3 = p + 6*h;
+        int32_t br, bi, cr, ci, dr, di;
+        cmul_s16(w2, p1, br, bi);
+        cmul_s16(w1, p2, cr, ci);
+        cmul_s16(w3, p3, dr, di);
+        const int32_t t0r = p[0] + br, t0i = p[1] + bi, t1r = p[0] - br, t1i = p[1] - bi;
+        const int32_t t2r = cr + dr, t2i = ci + di, t3r = ci - di, t3i = dr - cr; /* t3 = -j(c - d) */
+        p[0] = sat16((t0r + t2r) >> 2);
+        p[1] = sat16((t0i + t2i) >> 2);
+        p2[0] = sat16((t0r - t2r) >> 2);
+        p2[1] = sat16((t0i - t2i) >> 2);
+        p1[0] = sat16((t1r + t3r) >> 2);
+        p1[1] = sat16((t1i + t3i) >> 2);
+        p3[0] = sat16((t1r - t3r) >> 2);
+        p3[1] = sat16((t1i - t3i) >> 2);
+      }
+    }
+  return ESP_OK;
+}
+
+#endif
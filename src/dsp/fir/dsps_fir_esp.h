@@ -0,0 +1,79 @@
+#ifndef _custom_dsps_fir_H_
+#define _custom_dsps_fir_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Decimating FIR over a contiguous window
+ *
+ * y[n] = sum(x[n*decim + m]*coeffs[m]); m=[0..ntaps), n=[0..len)
+ * The coefficients are in correlation order: coeffs[0] multiplies the oldest
+ * sample of the window. x must hold (len - 1)*decim + ntaps samples.
+ * On ESP32 devices the products go through the FPU (madd.s) on four
+ * accumulators; the samples may be at any address.
+ *
+ * @param x: input samples
+ * @param coeffs: time reversed filter coefficients
+ * @param y: output array with len elements
+ * @param len: amount of outputs
+ * @param ntaps: amount of coefficients
+ * @param decim: samples between two outputs
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fird_f32_esp(const float *x,\
+                            const float *coeffs,\
+                            float *y,\
+                            int len,\
+                            int ntaps,\
+                            int decim);
+
+/**
+ * @brief Decimating FIR over a contiguous window, for fixed point samples
+ *
+ * y[n] = sat16(sum(x[n*decim + m]*coeffs[m]) >> shift); m=[0..ntaps), n=[0..len)
+ * The coefficients are in correlation order: coeffs[0] multiplies the oldest
+ * sample of the window. x must hold (len - 1)*decim + ntaps samples.
+ * The products are accumulated without any loss (40 bits accumulator). With
+ * shift as the fractional bits of the coefficients, y keeps the fixed point
+ * format of x.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * ee.vmulas.s16.accx over 8 coefficients at a time, the window being read
+ * at any address (ee.ld.128.usar.ip / ee.src.q.qup).
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned coefficients can be used with it.
+ * If you are using espmath::Fir, you don't have to worry about it.
+ *
+ * @param x: input samples
+ * @param coeffs: time reversed filter coefficients
+ * @param y: output array with len elements
+ * @param len: amount of outputs
+ * @param ntaps: amount of coefficients
+ * @param decim: samples between two outputs
+ * @param shift: right shift applied to the accumulated products
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_fird_s16_esp(const int16_t *x,\
+                            const int16_t *coeffs,\
+                            int16_t *y,\
+                            int len,\
+                            int ntaps,\
+                            int decim,\
+                            int shift);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_fir_H_
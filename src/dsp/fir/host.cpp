@@ -0,0 +1,50 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_fir_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_fird_f32_esp(const float *x, const float *coeffs, float *y, int len, int ntaps, int decim)
+{
+  for (int n = 0; n < len; n++, x += decim)
+  {
+    float acc = 0;
+    int m = 0;
+#if DSPS_HOST_SIMD
+    v_f32 acc_v = {};
+    for (; m + DSPS_LANES(float) <= ntaps; m += DSPS_LANES(float))
+      acc_v += vload<v_f32>(x + m) * vload<v_f32>(coeffs + m);
+    acc = vhsum<float>(acc_v);
+#endif
+    for (; m < ntaps; m++)
+      acc += x[m] * coeffs[m];
+    y[n] = acc;
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_fird_s16_esp(const int16_t *x, const int16_t *coeffs, int16_t *y, int len, int ntaps, int decim, int shift)
+{
+  for (int n = 0; n < len; n++, x += decim)
+  {
+    int64_t acc = 0;
+    int m = 0;
+#if DSPS_HOST_SIMD
+    v_s16q acc_v = {};
+    for (; m + DSPS_LANES(int16_t) <= ntaps; m += DSPS_LANES(int16_t))
+    {
+      const v_s16w p = __builtin_convertvector(vload<v_s16>(x + m), v_s16w) * __builtin_convertvector(vload<v_s16>(coeffs + m), v_s16w);
+      acc_v += __builtin_convertvector(p, v_s16q);
+    }
+    acc = vhsum<int64_t>(acc_v);
+#endif
+    for (; m < ntaps; m++)
+      acc += (int32_t)x[m] * coeffs[m];
+    y[n] = sat16(sat32(acc >> shift));
+  }
+  return ESP_OK;
+}
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef _custom_dsps_converter_H_
 #define _custom_dsps_converter_H_
 
-#include "dsp_err.h"
+#include "../../esp_platform.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -41,6 +41,43 @@ esp_err_t dsps_s163_f32_esp(const int16_t *x, float *y, int len, int step_x = 1,
 esp_err_t dsps_s162_f32_esp(const int16_t *x, float *y, int len, int step_x = 1, int step_y = 1);
 esp_err_t dsps_s161_f32_esp(const int16_t *x, float *y, int len, int step_x = 1, int step_y = 1);
 
+/**
+ * @brief Convert float array to 32 bits fixed point array
+ *
+ * y[i] = round(x[i]*2^frac), saturated to int32_t. Q16.16 and Q31 are
+ * frac = 16 and frac = 31.
+ *
+ * @param x: input array
+ * @param y: output result
+ * @param frac: Fractional part, [0..31]
+ * @param len: amount of operations for arrays
+ * @param step_x: step for input x
+ * @param step_y: step for input y
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_f32_s32_esp(const float *x, int32_t *y, int frac = 16, int len = 1, int step_x = 1, int step_y = 1);
+
+/**
+ * @brief Convert 32 bits fixed point array to float array
+ *
+ * y[i] = x[i]/2^frac
+ *
+ * @param x: input array
+ * @param y: output result
+ * @param frac: Fractional part, [0..31]
+ * @param len: amount of operations for arrays
+ * @param step_x: step for input x
+ * @param step_y: step for input y
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_s32_f32_esp(const int32_t *x, float *y, int frac = 16, int len = 1, int step_x = 1, int step_y = 1);
+
 /**@}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,174 @@
+#ifndef _custom_dsps_fixed_mode_H_
+#define _custom_dsps_fixed_mode_H_
+
+/**
+ * @brief Rounding and overflow modes of the int16 fixed point kernels
+ *
+ * A mode is one rounding mode or'ed with one overflow mode, e.g.
+ * DSPS_FIXED_NEAREST | DSPS_FIXED_SATURATE.
+ *
+ * Rounding, when frac bits are dropped by a product or a quotient:
+ * - DSPS_FIXED_TRUNCATE: products are shifted right (toward -inf), quotients
+ * are truncated toward zero, as the default kernels do;
+ * - DSPS_FIXED_NEAREST: to nearest, halves up for products and away from
+ * zero for quotients;
+ * - DSPS_FIXED_CONVERGENT: to nearest, halves to even.
+ *
+ * Overflow, when the result does not fit 16 bits:
+ * - DSPS_FIXED_WRAP: the low 16 bits are kept;
+ * - DSPS_FIXED_SATURATE: the result is clamped to [INT16_MIN, INT16_MAX].
+ */
+#define DSPS_FIXED_TRUNCATE   0
+#define DSPS_FIXED_NEAREST    1
+#define DSPS_FIXED_CONVERGENT 2
+#define DSPS_FIXED_ROUNDING   3 // rounding bits of a mode
+
+#define DSPS_FIXED_WRAP       0
+#define DSPS_FIXED_SATURATE   4
+
+#ifndef __ASSEMBLER__
+
+#include "../../esp_platform.h"
+
+/**
+ * @brief p >> frac, rounded as mode says
+ */
+static inline int32_t dsps_fixed_shift(int32_t p, const int frac, const int mode)
+{
+  const int rounding = frac ? (mode & DSPS_FIXED_ROUNDING) : DSPS_FIXED_TRUNCATE;
+  if (rounding == DSPS_FIXED_NEAREST)
+    p += (int32_t)1 << (frac - 1);
+  else if (rounding == DSPS_FIXED_CONVERGENT)
+    p += ((int32_t)1 << (frac - 1)) - 1 + ((p >> frac) & 1);
+  return p >> frac;
+}
+
+/**
+ * @brief n/d, rounded as mode says
+ */
+static inline int32_t dsps_fixed_quotient(const int32_t n, const int32_t d, const int mode)
+{
+  const int rounding = mode & DSPS_FIXED_ROUNDING;
+  if (rounding == DSPS_FIXED_TRUNCATE)
+    return n / d;
+  const int32_t half = (d < 0 ? -d : d) >> 1;
+  const int32_t t = n < 0 ? n - half : n + half;
+  int32_t q = t / d;
+  /* t is a multiple of an even d only when n/d is a tie */
+  if (rounding == DSPS_FIXED_CONVERGENT && !(d & 1) && q*d == t && (q & 1))
+    q -= q < 0 ? -1 : 1;
+  return q;
+}
+
+/**
+ * @brief n/d on 64 bits, rounded as dsps_fixed_quotient does
+ */
+static inline int64_t dsps_fixed_quotient64(const int64_t n, const int64_t d, const int mode)
+{
+  const int rounding = mode & DSPS_FIXED_ROUNDING;
+  if (rounding == DSPS_FIXED_TRUNCATE)
+    return n / d;
+  const int64_t half = (d < 0 ? -d : d) >> 1;
+  const int64_t t = n < 0 ? n - half : n + half;
+  int64_t q = t / d;
+  if (rounding == DSPS_FIXED_CONVERGENT && !(d & 1) && q*d == t && (q & 1))
+    q -= q < 0 ? -1 : 1;
+  return q;
+}
+
+/**
+ * @brief Back to 16 bits, wrapped or saturated as mode says
+ */
+static inline int16_t dsps_fixed_narrow_s16(const int32_t value, const int mode)
+{
+  if (mode & DSPS_FIXED_SATURATE)
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  return (int16_t)value;
+}
+
+/**
+ * @brief 64 bits value back to 16 bits, wrapped or saturated as mode says
+ */
+static inline int16_t dsps_fixed_narrow64_s16(const int64_t value, const int mode)
+{
+  if (mode & DSPS_FIXED_SATURATE)
+    return (int16_t)(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+  return (int16_t)(uint16_t)(uint64_t)value;
+}
+
+/**
+ * @brief a*b of two Q(frac) values, as dsps_mul_s16_mode_esp computes it
+ */
+static inline int16_t dsps_fixed_mul_s16(const int16_t a, const int16_t b, const int frac, const int mode)
+{
+  return dsps_fixed_narrow_s16(dsps_fixed_shift((int32_t)a*b, frac, mode), mode);
+}
+
+/**
+ * @brief a/b of two Q(frac) values, as dsps_div_s16_mode_esp computes it
+ */
+static inline int16_t dsps_fixed_div_s16(const int16_t a, const int16_t b, const int frac, const int mode)
+{
+  return dsps_fixed_narrow_s16(dsps_fixed_quotient((int32_t)a*((int32_t)1 << frac), b, mode), mode);
+}
+
+/**
+ * @brief Q(from) value to Q(to), rounded as mode says and saturated to 16 bits
+ */
+static inline int16_t dsps_fixed_align_s16(int32_t value, const int from, const int to, const int mode)
+{
+  if (from > to)
+    value = dsps_fixed_shift(value, from - to, mode);
+  value = dsps_fixed_narrow_s16(value, DSPS_FIXED_SATURATE);
+  return dsps_fixed_narrow_s16(value*((int32_t)1 << (to > from ? to - from : 0)), DSPS_FIXED_SATURATE);
+}
+
+/**
+ * @brief a + b of a Q(frac_a) and a Q(frac_b) value, in Q(frac_y), as
+ * dsps_add_s16_q_esp computes it. The sum is exact in the finer format of
+ * the operands, then rounded as mode says and saturated.
+ */
+static inline int16_t dsps_fixed_add_q_s16(const int16_t a, const int frac_a, const int16_t b, const int frac_b, const int frac_y, const int mode)
+{
+  const int frac = frac_a > frac_b ? frac_a : frac_b;
+  return dsps_fixed_align_s16((int32_t)a*((int32_t)1 << (frac - frac_a)) + (int32_t)b*((int32_t)1 << (frac - frac_b)), frac, frac_y, mode);
+}
+
+/**
+ * @brief a - b of a Q(frac_a) and a Q(frac_b) value, in Q(frac_y), as dsps_sub_s16_q_esp computes it
+ */
+static inline int16_t dsps_fixed_sub_q_s16(const int16_t a, const int frac_a, const int16_t b, const int frac_b, const int frac_y, const int mode)
+{
+  const int frac = frac_a > frac_b ? frac_a : frac_b;
+  return dsps_fixed_align_s16((int32_t)a*((int32_t)1 << (frac - frac_a)) - (int32_t)b*((int32_t)1 << (frac - frac_b)), frac, frac_y, mode);
+}
+
+/**
+ * @brief a*b of a Q(frac_a) and a Q(frac_b) value, in Q(frac_y): the
+ * Q(frac_a + frac_b) product shifted by frac_a + frac_b - frac_y
+ */
+static inline int16_t dsps_fixed_mul_q_s16(const int16_t a, const int frac_a, const int16_t b, const int frac_b, const int frac_y, const int mode)
+{
+  const int shift = frac_a + frac_b - frac_y;
+  if (shift >= 0)
+    return dsps_fixed_narrow_s16(dsps_fixed_shift((int32_t)a*b, shift, mode), mode);
+  return dsps_fixed_narrow64_s16((int64_t)a*b*((int64_t)1 << -shift), mode);
+}
+
+/**
+ * @brief a/b of a Q(frac_a) and a Q(frac_b) value, in Q(frac_y): a shifted
+ * by frac_y + frac_b - frac_a, divided by b
+ */
+static inline int16_t dsps_fixed_div_q_s16(const int16_t a, const int frac_a, const int16_t b, const int frac_b, const int frac_y, const int mode)
+{
+  const int shift = frac_y + frac_b - frac_a;
+  if (shift < 0)
+    return dsps_fixed_narrow_s16(dsps_fixed_quotient(a, (int32_t)b*((int32_t)1 << -shift), mode), mode);
+  if (shift <= 16)
+    return dsps_fixed_narrow_s16(dsps_fixed_quotient((int32_t)a*((int32_t)1 << shift), b, mode), mode);
+  return dsps_fixed_narrow64_s16(dsps_fixed_quotient64((int64_t)a*((int64_t)1 << shift), b, mode), mode);
+}
+
+#endif
+
+#endif // _dsps_fixed_mode_H_
@@ -0,0 +1,96 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "converter.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/*
+ * float -> Q(frac): round to nearest (as round.s does) and keep the 16 low bits.
+ * Q(frac) -> float: x / 2^frac.
+ */
+#if DSPS_HOST_SIMD
+#define DSPS_HOST_F32_S16_VECTOR(FRAC)\
+  if (step_x == 1 && step_y == 1)\
+  {\
+    const v_f32 scale = vbroadcast<v_f32>((float)(1 << FRAC));\
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))\
+    {\
+      const v_s32 r = vround(vload<v_f32>(x + i) * scale);\
+      for (int l = 0; l < DSPS_LANES(float); l++)\
+        y[i + l] = (int16_t)r[l];\
+    }\
+  }
+#define DSPS_HOST_S16_F32_VECTOR(FRAC)\
+  if (step_x == 1 && step_y == 1)\
+  {\
+    const v_f32 scale = vbroadcast<v_f32>(1.f / (float)(1 << FRAC));\
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))\
+    {\
+      v_f32 r;\
+      for (int l = 0; l < DSPS_LANES(float); l++)\
+        r[l] = (float)x[i + l];\
+      vstore(y + i, r * scale);\
+    }\
+  }
+#else
+#define DSPS_HOST_F32_S16_VECTOR(FRAC)
+#define DSPS_HOST_S16_F32_VECTOR(FRAC)
+#endif
+
+#define DSPS_HOST_CONVERTERS(FRAC)\
+esp_err_t dsps_f32_s16##FRAC##_esp(const float *x, int16_t *y, int len, int step_x, int step_y)\
+{\
+  int i = 0;\
+  DSPS_HOST_F32_S16_VECTOR(FRAC)\
+  for (; i < len; i++)\
+    y[i*step_y] = (int16_t)lrintf(x[i*step_x] * (float)(1 << FRAC));\
+  return ESP_OK;\
+}\
+esp_err_t dsps_s16##FRAC##_f32_esp(const int16_t *x, float *y, int len, int step_x, int step_y)\
+{\
+  int i = 0;\
+  DSPS_HOST_S16_F32_VECTOR(FRAC)\
+  for (; i < len; i++)\
+    y[i*step_y] = (float)x[i*step_x] / (float)(1 << FRAC);\
+  return ESP_OK;\
+}
+
+DSPS_HOST_CONVERTERS(15)
+DSPS_HOST_CONVERTERS(14)
+DSPS_HOST_CONVERTERS(13)
+DSPS_HOST_CONVERTERS(12)
+DSPS_HOST_CONVERTERS(11)
+DSPS_HOST_CONVERTERS(10)
+DSPS_HOST_CONVERTERS(9)
+DSPS_HOST_CONVERTERS(8)
+DSPS_HOST_CONVERTERS(7)
+DSPS_HOST_CONVERTERS(6)
+DSPS_HOST_CONVERTERS(5)
+DSPS_HOST_CONVERTERS(4)
+DSPS_HOST_CONVERTERS(3)
+DSPS_HOST_CONVERTERS(2)
+DSPS_HOST_CONVERTERS(1)
+
+/* The device multiplies by 2^frac (or 2^-frac) first: round.s and float.s only scale by 2^[0..15]. */
+esp_err_t dsps_f32_s32_esp(const float *x, int32_t *y, int frac, int len, int step_x, int step_y)
+{
+  const double scale = (double)((int64_t)1 << frac);
+  for (int i = 0; i < len; i++)
+  {
+    const double value = nearbyint((double)x[i*step_x] * scale);
+    y[i*step_y] = value >= (double)INT32_MAX ? INT32_MAX : (value <= (double)INT32_MIN ? INT32_MIN : (int32_t)value);
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_s32_f32_esp(const int32_t *x, float *y, int frac, int len, int step_x, int step_y)
+{
+  const float scale = 1.f / (float)((int64_t)1 << frac);
+  for (int i = 0; i < len; i++)
+    y[i*step_y] = (float)x[i*step_x] * scale;
+  return ESP_OK;
+}
+
+#endif
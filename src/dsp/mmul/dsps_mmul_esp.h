@@ -0,0 +1,80 @@
+#ifndef _custom_dsps_mmul_H_
+#define _custom_dsps_mmul_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Matrix multiplication
+ *
+ * C[m][k] = A[m][n] * B[n][k]. Matrices are stored row by row.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * every row of A goes through B four columns at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * The vector path also needs k to be a multiple of 4, otherwise the scalar path is used.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param A: input matrix, m rows by n columns
+ * @param B: input matrix, n rows by k columns
+ * @param C: output matrix, m rows by k columns
+ * @param m: rows of A
+ * @param n: columns of A and rows of B
+ * @param k: columns of B
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mmul_f32_esp(const float *A,\
+                            const float *B,\
+                            float *C,\
+                            int m,\
+                            int n,\
+                            int k);
+
+/**
+ * @brief Matrix multiplication
+ *
+ * C[m][k] = A[m][n] * B[n][k]. Matrices are stored row by row.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * every row of A goes through B eight columns at a time.
+ * Also, it uses fixed-point arithmetic. The products are accumulated without
+ * being shifted (on 32 bits at least), then every result is shifted right by
+ * frac and saturated to 16 bits.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * The vector path also needs k to be a multiple of 8, otherwise the scalar path is used.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param A: input matrix, m rows by n columns
+ * @param B: input matrix, n rows by k columns
+ * @param C: output matrix, m rows by k columns
+ * @param m: rows of A
+ * @param n: columns of A and rows of B
+ * @param k: columns of B
+ * @param frac: Fractional number (by default 0)
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mmul_s16_esp(const int16_t *A,\
+                            const int16_t *B,\
+                            int16_t *C,\
+                            int m,\
+                            int n,\
+                            int k,\
+                            int frac = 0);
+
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_mmul_H_
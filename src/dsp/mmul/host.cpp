@@ -0,0 +1,120 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_mmul_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+/*
+ * Columns of B (and C) per block. Every row of A goes through the same
+ * n x DSPS_MMUL_BLOCK panel of B, which stays in cache meanwhile.
+ */
+#define DSPS_MMUL_BLOCK 128
+
+/*
+ * Rows of A per tile. A tile keeps DSPS_MMUL_ROWS rows by one vector of C
+ * in registers while it walks down the panel of B, so every B load feeds
+ * DSPS_MMUL_ROWS multiply-adds.
+ */
+#define DSPS_MMUL_ROWS 4
+
+#if DSPS_HOST_SIMD
+template<int ROWS>
+inline void mmul_tile_f32(const float *A, const float *B, float *C, int n, int k)
+{
+  v_f32 acc[ROWS] = {};
+  for (int p = 0; p < n; p++)
+  {
+    const v_f32 b = vload<v_f32>(B + p*k);
+    for (int r = 0; r < ROWS; r++)
+      acc[r] += A[r*n + p] * b;
+  }
+  for (int r = 0; r < ROWS; r++)
+    vstore(C + r*k, acc[r]);
+}
+
+template<int ROWS>
+inline void mmul_tile_s16(const int16_t *A, const int16_t *B, int16_t *C, int n, int k, int frac)
+{
+  v_s16w acc[ROWS] = {};
+  for (int p = 0; p < n; p++)
+  {
+    const v_s16w b = __builtin_convertvector(vload<v_s16>(B + p*k), v_s16w);
+    for (int r = 0; r < ROWS; r++)
+      acc[r] += (int32_t)A[r*n + p] * b;
+  }
+  for (int r = 0; r < ROWS; r++)
+    vstore(C + r*k, vclamp16(acc[r] >> frac));
+}
+#endif
+
+inline void mmul_column_f32(const float *A, const float *B, float *C, int m, int n, int k)
+{
+  for (int i = 0; i < m; i++)
+  {
+    float acc = 0;
+    for (int p = 0; p < n; p++)
+      acc += A[i*n + p] * B[p*k];
+    C[i*k] = acc;
+  }
+}
+
+inline void mmul_column_s16(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int frac)
+{
+  for (int i = 0; i < m; i++)
+  {
+    int32_t acc = 0;
+    for (int p = 0; p < n; p++)
+      acc = wadd32(acc, (int32_t)A[i*n + p] * B[p*k]);
+    C[i*k] = sat16(acc >> frac);
+  }
+}
+
+esp_err_t dsps_mmul_f32_esp(const float *A, const float *B, float *C, int m, int n, int k)
+{
+  for (int j0 = 0; j0 < k; j0 += DSPS_MMUL_BLOCK)
+  {
+    const int j1 = j0 + DSPS_MMUL_BLOCK < k ? j0 + DSPS_MMUL_BLOCK : k;
+    int j = j0;
+#if DSPS_HOST_SIMD
+    const int vectors = (j1 - j0)/DSPS_LANES(float);
+    int i = 0;
+    for (; i + DSPS_MMUL_ROWS <= m; i += DSPS_MMUL_ROWS)
+      for (int v = 0; v < vectors; v++)
+        mmul_tile_f32<DSPS_MMUL_ROWS>(A + i*n, B + j0 + v*DSPS_LANES(float), C + i*k + j0 + v*DSPS_LANES(float), n, k);
+    for (; i < m; i++)
+      for (int v = 0; v < vectors; v++)
+        mmul_tile_f32<1>(A + i*n, B + j0 + v*DSPS_LANES(float), C + i*k + j0 + v*DSPS_LANES(float), n, k);
+    j += vectors*DSPS_LANES(float);
+#endif
+    for (; j < j1; j++)
+      mmul_column_f32(A, B + j, C + j, m, n, k);
+  }
+  return ESP_OK;
+}
+
+esp_err_t dsps_mmul_s16_esp(const int16_t *A, const int16_t *B, int16_t *C, int m, int n, int k, int frac)
+{
+  for (int j0 = 0; j0 < k; j0 += DSPS_MMUL_BLOCK)
+  {
+    const int j1 = j0 + DSPS_MMUL_BLOCK < k ? j0 + DSPS_MMUL_BLOCK : k;
+    int j = j0;
+#if DSPS_HOST_SIMD
+    const int vectors = (j1 - j0)/DSPS_LANES(int16_t);
+    int i = 0;
+    for (; i + DSPS_MMUL_ROWS <= m; i += DSPS_MMUL_ROWS)
+      for (int v = 0; v < vectors; v++)
+        mmul_tile_s16<DSPS_MMUL_ROWS>(A + i*n, B + j0 + v*DSPS_LANES(int16_t), C + i*k + j0 + v*DSPS_LANES(int16_t), n, k, frac);
+    for (; i < m; i++)
+      for (int v = 0; v < vectors; v++)
+        mmul_tile_s16<1>(A + i*n, B + j0 + v*DSPS_LANES(int16_t), C + i*k + j0 + v*DSPS_LANES(int16_t), n, k, frac);
+    j += vectors*DSPS_LANES(int16_t);
+#endif
+    for (; j < j1; j++)
+      mmul_column_s16(A, B + j, C + j, m, n, k, frac);
+  }
+  return ESP_OK;
+}
+
+#endif
@@ -1,8 +1,11 @@
 #ifndef _custom_dsps_mul_H_
 #define _custom_dsps_mul_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
+#include "../fixed/dsps_fixed_mode.h"
 
+#if !ESP_MATH_HOST
 #include "dsps_mul_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -119,6 +122,62 @@ esp_err_t dsps_mul_f32_esp(const float *x1,\
                           int step_x2 = 1,\
                           int step_y  = 1);
 
+/**
+ * @brief   multiply fixed point arrays
+ *
+ * y[i] = (x1[i]*x2[i]) >> frac; i=[0..len)
+ * The product is kept on 64 bits (mull and mulsh) before the shift, so
+ * Q16.16 or Q31 arrays are multiplied without losing their integer part.
+ * 
+ * @param x1: input array
+ * @param x2: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param frac: Fractional part. For instance, if Q16.16, then frac = 16
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mul_fixed_s32_esp(const int32_t *x1,\
+                                 const int32_t *x2,\
+                                 int32_t *y,\
+                                 int len,\
+                                 int step_x1 = 1,\
+                                 int step_x2 = 1,\
+                                 int step_y  = 1,\
+                                 int frac = 16);
+
+/**
+ * @brief   multiply fixed point arrays, with a rounding and an overflow mode
+ *
+ * y[i] = (x1[i]*x2[i]) >> frac; i=[0..len)
+ * The product is rounded and narrowed to 16 bits as mode says (see
+ * dsps_fixed_mode.h), in the same pass. Truncating modes keep the vector
+ * path of dsps_mul_s16_esp.
+ * 
+ * @param x1: input array
+ * @param x2: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param frac: Fractional part. For instance, if Q15, then frac = 15
+ * @param mode: DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT,
+ * or'ed with DSPS_FIXED_WRAP or DSPS_FIXED_SATURATE
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mul_s16_mode_esp(const int16_t *x1,\
+                                const int16_t *x2,\
+                                int16_t *y,\
+                                int len,\
+                                int step_x1 = 1,\
+                                int step_x2 = 1,\
+                                int step_y  = 1,\
+                                int frac = 0,\
+                                int mode = DSPS_FIXED_TRUNCATE);
+
 /**@}*/
 
 #ifdef __cplusplus
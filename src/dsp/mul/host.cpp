@@ -0,0 +1,85 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_mul_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_mul_s8_esp(const int8_t *x1, const int8_t *x2, int8_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+    {
+      const v_s8w p = __builtin_convertvector(vload<v_s8>(x1 + i), v_s8w) * __builtin_convertvector(vload<v_s8>(x2 + i), v_s8w);
+      vstore(y + i, __builtin_convertvector(p, v_s8));
+    }
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = (int8_t)((int32_t)x1[i*step_x1] * x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mul_s16_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vmul(vload<v_s16>(x1 + i), vload<v_s16>(x2 + i), frac));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = (int16_t)(((int32_t)x1[i*step_x1] * x2[i*step_x2]) >> frac);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mul_s16_mode_esp(const int16_t *x1, const int16_t *x2, int16_t *y, int len, int step_x1, int step_x2, int step_y, int frac, int mode)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(y + i, vmul(vload<v_s16>(x1 + i), vload<v_s16>(x2 + i), frac, mode));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = dsps_fixed_mul_s16(x1[i*step_x1], x2[i*step_x2], frac, mode);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mul_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(y + i, (v_s32)((v_u32)vload<v_s32>(x1 + i) * (v_u32)vload<v_s32>(x2 + i)));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = wmul32(x1[i*step_x1], x2[i*step_x2]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mul_f32_esp(const float *x1, const float *x2, float *y, int len, int step_x1, int step_x2, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x1 == 1 && step_x2 == 1 && step_y == 1)
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(y + i, vload<v_f32>(x1 + i) * vload<v_f32>(x2 + i));
+#endif
+  for (; i < len; i++)
+    y[i*step_y] = x1[i*step_x1] * x2[i*step_x2];
+  return ESP_OK;
+}
+
+/* 64 bits product, as mull and mulsh give it, shifted by frac */
+esp_err_t dsps_mul_fixed_s32_esp(const int32_t *x1, const int32_t *x2, int32_t *y, int len, int step_x1, int step_x2, int step_y, int frac)
+{
+  for (int i = 0; i < len; i++)
+    y[i*step_y] = (int32_t)(((int64_t)x1[i*step_x1] * x2[i*step_x2]) >> frac);
+  return ESP_OK;
+}
+
+#endif
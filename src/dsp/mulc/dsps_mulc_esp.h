@@ -1,8 +1,11 @@
 #ifndef _custom_dsps_mulc_H_
 #define _custom_dsps_mulc_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
+#include "../fixed/dsps_fixed_mode.h"
 
+#if !ESP_MATH_HOST
 #include "dsps_mulc_platform.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -119,6 +122,58 @@ esp_err_t dsps_mulc_f32_esp(const float *input,\
                             int step_x = 1,\
                             int step_y = 1);
 
+/**
+ * @brief   multiply fixed point array by constant
+ *
+ * y[i] = (x[i]*C) >> frac; i=[0..len), the product being kept on 64 bits.
+ *
+ * @param input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param C: constant value
+ * @param frac: Fractional part. For instance, if Q16.16, then frac = 16
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mulc_fixed_s32_esp(const int32_t *input,\
+                                  int32_t *output,\
+                                  int len,\
+                                  int32_t C,\
+                                  int step_x = 1,\
+                                  int step_y = 1,\
+                                  int frac = 16);
+
+/**
+ * @brief   multiply fixed point array by constant, with a rounding and an overflow mode
+ *
+ * y[i] = (x[i]*C) >> frac; i=[0..len)
+ * The product is rounded and narrowed to 16 bits as mode says (see
+ * dsps_fixed_mode.h), in the same pass. Saturating and truncating modes
+ * keep the vector path of dsps_mulc_s16_esp.
+ *
+ * @param input: input array
+ * @param output: output array
+ * @param len: amount of operations for arrays
+ * @param C: constant value
+ * @param frac: Fractional part. For instance, if Q15, then frac = 15
+ * @param mode: DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT,
+ * or'ed with DSPS_FIXED_WRAP or DSPS_FIXED_SATURATE
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_mulc_s16_mode_esp(const int16_t *input,\
+                                 int16_t *output,\
+                                 int len,\
+                                 const int16_t C,\
+                                 int step_x = 1,\
+                                 int step_y = 1,\
+                                 int frac = 0,\
+                                 int mode = DSPS_FIXED_TRUNCATE);
+
 /**@}*/
 
 #ifdef __cplusplus
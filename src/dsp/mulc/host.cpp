@@ -0,0 +1,98 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_mulc_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_mulc_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t* C, int step_x, int step_y)
+{
+  const int32_t c = *C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    /* Only the low byte of the product is kept, so it can be computed in 8 bits */
+    const v_s8 c_v = vbroadcast<v_s8>(*C);
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(output + i, vload<v_s8>(input + i) * c_v);
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = (int8_t)(input[i*step_x] * c);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mulc_s16_esp(const int16_t *input, int16_t *output, int len, int16_t C, int step_x, int step_y, int frac)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(output + i, vmuls(vload<v_s16>(input + i), c_v, frac));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = sat16(((int32_t)input[i*step_x] * C) >> frac);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mulc_s16_mode_esp(const int16_t *input, int16_t *output, int len, const int16_t C, int step_x, int step_y, int frac, int mode)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(output + i, vmul(vload<v_s16>(input + i), c_v, frac, mode));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = dsps_fixed_mul_s16(input[i*step_x], C, frac, mode);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mulc_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_u32 c_v = vbroadcast<v_u32>((uint32_t)C);
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(output + i, (v_s32)((v_u32)vload<v_s32>(input + i) * c_v));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = wmul32(input[i*step_x], C);
+  return ESP_OK;
+}
+
+esp_err_t dsps_mulc_f32_esp(const float *input, float *output, int len, const float C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_f32 c_v = vbroadcast<v_f32>(C);
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(output + i, vload<v_f32>(input + i) * c_v);
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = input[i*step_x] * C;
+  return ESP_OK;
+}
+
+esp_err_t dsps_mulc_fixed_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_x, int step_y, int frac)
+{
+  for (int i = 0; i < len; i++)
+    output[i*step_y] = (int32_t)(((int64_t)input[i*step_x] * C) >> frac);
+  return ESP_OK;
+}
+
+#endif
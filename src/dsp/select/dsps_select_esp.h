@@ -0,0 +1,73 @@
+#ifndef _custom_dsps_select_H_
+#define _custom_dsps_select_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Element-wise select between two arrays
+ *
+ * y[i] = x1[i] when bit i of the mask (bit i%32 of mask[i/32]) is set,
+ * x2[i] otherwise.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * 16 bits of the mask are expanded into lane masks (ee.vcmp.eq.s16 against
+ * the lane weights) and blend 16 elements at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x1: input array, selected where the mask is set
+ * @param x2: input array, selected where the mask is clear
+ * @param mask: bitmask of (len + 31)/32 words
+ * @param y: output array
+ * @param len: amount of elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_select_s16_esp(const int16_t *x1,\
+                              const int16_t *x2,\
+                              const uint32_t *mask,\
+                              int16_t *y,\
+                              int len);
+
+/**
+ * @brief Element-wise select between two arrays
+ *
+ * y[i] = x1[i] when bit i of the mask (bit i%32 of mask[i/32]) is set,
+ * x2[i] otherwise. Elements are copied as they are, so it serves float
+ * arrays as well.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * 16 bits of the mask are expanded into lane masks (ee.vcmp.eq.s32 against
+ * the lane weights) and blend 16 elements at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x1: input array, selected where the mask is set
+ * @param x2: input array, selected where the mask is clear
+ * @param mask: bitmask of (len + 31)/32 words
+ * @param y: output array
+ * @param len: amount of elements
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_select_s32_esp(const int32_t *x1,\
+                              const int32_t *x2,\
+                              const uint32_t *mask,\
+                              int32_t *y,\
+                              int len);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_select_H_
@@ -0,0 +1,49 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_select_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+template<typename T, typename V>
+inline void select_elements(const T *x1, const T *x2, const uint32_t *mask, T *y, int len)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  /* Lane j tests bit j of the broadcast mask bits: 0 or -1 */
+  V weights;
+  for (int j = 0; j < DSPS_LANES(T); j++)
+    weights[j] = (T)((uint32_t)1 << j);
+  for (; i + DSPS_LANES(T) <= len; i += DSPS_LANES(T))
+  {
+    const V bits = vbroadcast<V>((T)(mask[i/32] >> (i % 32))) & weights;
+    const V lanes = (V)(bits == weights);
+    const V a = vload<V>(x1 + i);
+    const V b = vload<V>(x2 + i);
+    vstore(y + i, b ^ ((a ^ b) & lanes));
+  }
+#endif
+  for (; i < len; i++)
+    y[i] = (mask[i/32] >> (i % 32)) & 1 ? x1[i] : x2[i];
+}
+
+#if !DSPS_HOST_SIMD
+/* Only the scalar loop is instantiated, V is never used */
+typedef int16_t v_s16;
+typedef int32_t v_s32;
+#endif
+
+esp_err_t dsps_select_s16_esp(const int16_t *x1, const int16_t *x2, const uint32_t *mask, int16_t *y, int len)
+{
+  select_elements<int16_t, v_s16>(x1, x2, mask, y, len);
+  return ESP_OK;
+}
+
+esp_err_t dsps_select_s32_esp(const int32_t *x1, const int32_t *x2, const uint32_t *mask, int32_t *y, int len)
+{
+  select_elements<int32_t, v_s32>(x1, x2, mask, y, len);
+  return ESP_OK;
+}
+
+#endif
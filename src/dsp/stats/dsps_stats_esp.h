@@ -0,0 +1,142 @@
+#ifndef _custom_dsps_stats_H_
+#define _custom_dsps_stats_H_
+#include "../../esp_platform.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**@{*/
+/**
+ * @brief Minimum, maximum, sum and sum of squares of an array, in a single pass
+ *
+ * The sums are accumulated without any loss (40 bits accumulator) and
+ * returned on 64 bits. An empty array gives min = INT8_MAX, max = INT8_MIN
+ * and null sums.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * ee.vmin/ee.vmax and ee.vmulas.s8.accx over 64 elements at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param min: output minimum
+ * @param max: output maximum
+ * @param sum: output sum
+ * @param sumsq: output sum of squares. May be NULL, which saves its accumulation.
+ * @param len: amount of elements
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stats_s8_esp(const int8_t *x,\
+                            int8_t *min,\
+                            int8_t *max,\
+                            int64_t *sum,\
+                            int64_t *sumsq,\
+                            int len,\
+                            int step_x = 1);
+
+/**
+ * @brief Minimum, maximum, sum and sum of squares of an array, in a single pass
+ *
+ * The sum (40 bits accumulator) and the sum of squares (64 bits) are
+ * accumulated without any loss, up to 2^24 elements, and returned on
+ * 64 bits. An empty array gives min = INT16_MAX, max = INT16_MIN
+ * and null sums.
+ * The implementation target ESP32 devices and it's optimized using DSP instructions:
+ * ee.vmin/ee.vmax and ee.vmulas.s16.accx over 32 elements at a time.
+ *
+ * @note Caution. If MEMORY_ALIGN is enabled, only 16 bytes aligned data can be used with it.
+ * If you are using espmath::Array, you don't have to worry about it.
+ *
+ * @param x: input array
+ * @param min: output minimum
+ * @param max: output maximum
+ * @param sum: output sum
+ * @param sumsq: output sum of squares. May be NULL, which saves its accumulation.
+ * @param len: amount of elements
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stats_s16_esp(const int16_t *x,\
+                             int16_t *min,\
+                             int16_t *max,\
+                             int64_t *sum,\
+                             int64_t *sumsq,\
+                             int len,\
+                             int step_x = 1);
+
+/**
+ * @brief Minimum, maximum, sum and sum of squares of an array, in a single pass
+ *
+ * The sums are accumulated and returned on 64 bits; the sum of squares
+ * wraps around when it does not fit. An empty array gives min = INT32_MAX,
+ * max = INT32_MIN and null sums.
+ * PIE has no 32 bits multiply-accumulate, so on ESP32 devices the elements
+ * go through the MIN/MAX instructions and 64 bits additions one at a time.
+ *
+ * @param x: input array
+ * @param min: output minimum
+ * @param max: output maximum
+ * @param sum: output sum
+ * @param sumsq: output sum of squares. May be NULL.
+ * @param len: amount of elements
+ * @param step_x: step for input x
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stats_s32_esp(const int32_t *x,\
+                             int32_t *min,\
+                             int32_t *max,\
+                             int64_t *sum,\
+                             int64_t *sumsq,\
+                             int len,\
+                             int step_x = 1);
+
+/**
+ * @brief Minimum, maximum, sum and sum of squares of an array, in a single pass
+ *
+ * NaN elements are ignored by min and max. An empty array gives
+ * min = +INFINITY, max = -INFINITY and null sums.
+ * The sums are those of x - shift: with shift close to the elements, e.g.
+ * the first one, they hold the deviations rather than the magnitude of the
+ * elements, and the sum of squares does not lose them to rounding.
+ * On ESP32 devices the elements go through the FPU one at a time (madd.s).
+ *
+ * @param x: input array
+ * @param min: output minimum
+ * @param max: output maximum
+ * @param sum: output sum of x - shift
+ * @param sumsq: output sum of (x - shift)^2. May be NULL.
+ * @param len: amount of elements
+ * @param step_x: step for input x
+ * @param shift: value subtracted from the elements before they are summed
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - One of the error codes from DSP library
+ */
+esp_err_t dsps_stats_f32_esp(const float *x,\
+                             float *min,\
+                             float *max,\
+                             float *sum,\
+                             float *sumsq,\
+                             int len,\
+                             int step_x = 1,\
+                             float shift = 0);
+/**@}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _dsps_stats_H_
@@ -0,0 +1,100 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_stats_esp.h"
+#include "../dsps_host.h"
+#include <limits>
+
+using namespace espmath::host;
+
+/*
+ * S is the type of the sums. W holds each element of V and its square exactly,
+ * A accumulates them (one lane per element of V as well).
+ */
+template<typename T, typename S, typename V, typename W, typename A>
+inline esp_err_t stats_kernel(const T *x, T *min, T *max, S *sum, S *sumsq, int len, int step_x, T shift = 0)
+{
+  T mn = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+  T mx = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+  S s = 0, q = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && len >= DSPS_LANES(T))
+  {
+    V mn_v = vbroadcast<V>(mn);
+    V mx_v = vbroadcast<V>(mx);
+    const W shift_v = __builtin_convertvector(vbroadcast<V>(shift), W);
+    while (i + DSPS_LANES(T) <= len)
+    {
+      /* the accumulators are flushed every 2^16 vectors, so 32 bits lanes hold int8 squares */
+      A s_v = {}, q_v = {};
+      for (int n = 0; n < 65536 && i + DSPS_LANES(T) <= len; n++, i += DSPS_LANES(T))
+      {
+        const V v = vload<V>(x + i);
+        mn_v = v < mn_v ? v : mn_v;
+        mx_v = mx_v < v ? v : mx_v;
+        const W w = __builtin_convertvector(v, W) - shift_v;
+        s_v += __builtin_convertvector(w, A);
+        q_v += __builtin_convertvector(w * w, A);
+      }
+      s += vhsum<S>(s_v);
+      q += vhsum<S>(q_v);
+    }
+    for (int k = 0; k < DSPS_LANES(T); k++)
+    {
+      mn = mn_v[k] < mn ? mn_v[k] : mn;
+      mx = mx < mx_v[k] ? mx_v[k] : mx;
+    }
+  }
+#endif
+  for (; i < len; i++)
+  {
+    const T v = x[i*step_x];
+    mn = v < mn ? v : mn;
+    mx = mx < v ? v : mx;
+    const S d = (S)v - shift;
+    s += d;
+    q += d * d;
+  }
+  *min = mn;
+  *max = mx;
+  *sum = s;
+  if (sumsq)
+    *sumsq = q;
+  return ESP_OK;
+}
+
+#if !DSPS_HOST_SIMD
+/* Only the scalar loop is instantiated, V, W and A are never used */
+typedef int8_t v_s8;
+typedef int16_t v_s16;
+typedef int32_t v_s32;
+typedef float v_f32;
+typedef int16_t v_s8w;
+typedef int32_t v_s8q;
+typedef int32_t v_s16w;
+typedef int64_t v_s16q;
+typedef int64_t v_s32w;
+#endif
+
+esp_err_t dsps_stats_s8_esp(const int8_t *x, int8_t *min, int8_t *max, int64_t *sum, int64_t *sumsq, int len, int step_x)
+{
+  return stats_kernel<int8_t, int64_t, v_s8, v_s8w, v_s8q>(x, min, max, sum, sumsq, len, step_x);
+}
+
+esp_err_t dsps_stats_s16_esp(const int16_t *x, int16_t *min, int16_t *max, int64_t *sum, int64_t *sumsq, int len, int step_x)
+{
+  return stats_kernel<int16_t, int64_t, v_s16, v_s16w, v_s16q>(x, min, max, sum, sumsq, len, step_x);
+}
+
+esp_err_t dsps_stats_s32_esp(const int32_t *x, int32_t *min, int32_t *max, int64_t *sum, int64_t *sumsq, int len, int step_x)
+{
+  return stats_kernel<int32_t, int64_t, v_s32, v_s32w, v_s32w>(x, min, max, sum, sumsq, len, step_x);
+}
+
+esp_err_t dsps_stats_f32_esp(const float *x, float *min, float *max, float *sum, float *sumsq, int len, int step_x, float shift)
+{
+  return stats_kernel<float, float, v_f32, v_f32, v_f32>(x, min, max, sum, sumsq, len, step_x, shift);
+}
+
+#endif
@@ -1,6 +1,6 @@
 #ifndef _custom_dsps_subc_H_
 #define _custom_dsps_subc_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
 
 #include "../addc/dsps_addc_esp.h"
 
@@ -29,9 +29,9 @@ extern "C"
  *      - ESP_OK on success
  *      - One of the error codes from DSP library
  */
-inline esp_err_t dsps_subc_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C)
+inline esp_err_t dsps_subc_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_x = 1, int step_y = 1)
 {
-  return dsps_addc_s32_esp(input, output, len, C*(-1));
+  return dsps_addc_s32_esp(input, output, len, C*(-1), step_x, step_y);
 }
 
 /**
@@ -81,10 +81,10 @@ inline esp_err_t dsps_subc_s16_esp(const int16_t *input, int16_t *output, int le
  *      - ESP_OK on success
  *      - One of the error codes from DSP library
  */
-inline esp_err_t dsps_subc_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t* C)
+inline esp_err_t dsps_subc_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t* C, int step_x = 1, int step_y = 1)
 {
   const int8_t constant = (*C)*(-1);
-  return dsps_addc_s8_esp(input, output, len, &constant);
+  return dsps_addc_s8_esp(input, output, len, &constant, step_x, step_y);
 }
 
 /**
@@ -106,9 +106,9 @@ inline esp_err_t dsps_subc_s8_esp(const int8_t *input, int8_t *output, int len,
  *      - ESP_OK on success
  *      - One of the error codes from DSP library
  */
-inline esp_err_t dsps_subc_f32_esp(const float *input, float *output, int len, const float C)
+inline esp_err_t dsps_subc_f32_esp(const float *input, float *output, int len, const float C, int step_x = 1, int step_y = 1)
 {
-  return dsps_addc_f32_esp(input, output, len, C*(-1));
+  return dsps_addc_f32_esp(input, output, len, C*(-1), step_x, step_y);
 }
 
 /**
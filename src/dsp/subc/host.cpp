@@ -0,0 +1,75 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_subc_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_csub_s32_esp(const int32_t *input, int32_t *output, int len, int32_t C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_u32 c_v = vbroadcast<v_u32>((uint32_t)C);
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      vstore(output + i, (v_s32)(c_v - (v_u32)vload<v_s32>(input + i)));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = wsub32(C, input[i*step_x]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_csub_s16_esp(const int16_t *input, int16_t *output, int len, const int16_t* C, int step_x, int step_y, int frac)
+{
+  const int32_t c = *C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s16 c_v = vbroadcast<v_s16>(*C);
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      vstore(output + i, vsubs(c_v, vload<v_s16>(input + i)) >> frac);
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = sat16(c - input[i*step_x]) >> frac;
+  return ESP_OK;
+}
+
+esp_err_t dsps_csub_s8_esp(const int8_t *input, int8_t *output, int len, const int8_t* C, int step_x, int step_y)
+{
+  const int32_t c = *C;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_s8 c_v = vbroadcast<v_s8>(*C);
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      vstore(output + i, vsubs(c_v, vload<v_s8>(input + i)));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = sat8(c - input[i*step_x]);
+  return ESP_OK;
+}
+
+esp_err_t dsps_csub_f32_esp(const float *input, float *output, int len, const float C, int step_x, int step_y)
+{
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1 && step_y == 1)
+  {
+    const v_f32 c_v = vbroadcast<v_f32>(C);
+    for (; i + DSPS_LANES(float) <= len; i += DSPS_LANES(float))
+      vstore(output + i, c_v - vload<v_f32>(input + i));
+  }
+#endif
+  for (; i < len; i++)
+    output[i*step_y] = C - input[i*step_x];
+  return ESP_OK;
+}
+
+#endif
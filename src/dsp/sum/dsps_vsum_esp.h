@@ -1,6 +1,6 @@
 #ifndef _custom_dsps_vsum_H_
 #define _custom_dsps_vsum_H_
-#include "dsp_err.h"
+#include "../../esp_platform.h"
 #include "../mul/dsps_mul_esp.h"
 
 #ifdef __cplusplus
@@ -0,0 +1,66 @@
+#include "../../esp_platform.h"
+#if ESP_MATH_HOST
+
+#include "dsps_vsum_esp.h"
+#include "../dsps_host.h"
+
+using namespace espmath::host;
+
+esp_err_t dsps_vsum_s16_esp(const int16_t *x, int16_t *y, int len, int step_x)
+{
+  int32_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1)
+  {
+    v_s16 acc_v = {};  /* sum modulo 2^16, exactly what the int16_t result keeps */
+    for (; i + DSPS_LANES(int16_t) <= len; i += DSPS_LANES(int16_t))
+      acc_v = (v_s16)((v_u16)acc_v + (v_u16)vload<v_s16>(x + i));
+    acc = vhsum<int32_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += x[i*step_x];
+  *y = (int16_t)acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_vsum_s8_esp(const int8_t *x, int8_t *y, int len, int step_x)
+{
+  int32_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1)
+  {
+    v_s8 acc_v = {};  /* sum modulo 2^8, exactly what the int8_t result keeps */
+    for (; i + DSPS_LANES(int8_t) <= len; i += DSPS_LANES(int8_t))
+      acc_v = (v_s8)((v_u8)acc_v + (v_u8)vload<v_s8>(x + i));
+    acc = vhsum<int32_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc += x[i*step_x];
+  *y = (int8_t)acc;
+  return ESP_OK;
+}
+
+esp_err_t dsps_vsum_s32_esp(const int32_t *x, int32_t *y, int len, int step_x)
+{
+  int32_t acc = 0;
+  int i = 0;
+#if DSPS_HOST_SIMD
+  if (step_x == 1)
+  {
+    v_u32 acc_v = {};
+    for (; i + DSPS_LANES(int32_t) <= len; i += DSPS_LANES(int32_t))
+      acc_v += (v_u32)vload<v_s32>(x + i);
+    acc = (int32_t)vhsum<uint32_t>(acc_v);
+  }
+#endif
+  for (; i < len; i++)
+    acc = wadd32(acc, x[i*step_x]);
+  *y = acc;
+  return ESP_OK;
+}
+
+#endif
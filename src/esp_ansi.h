@@ -1,7 +1,7 @@
 #ifndef _ANSI_VERSION_H
 #define _ANSI_VERSION_H
 
-#include <Arduino.h>
+#include "esp_platform.h"
 
 namespace espmath{
 
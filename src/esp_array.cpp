@@ -1,763 +1,993 @@
 #include "esp_array.h"
 
-#if defined BENCHMARK_TEST
-#include "esp_debug.h" // https://github.com/guilhAbreu/EspDebug
-#endif
-
-#if defined BENCHMARK_TEST
-#define REPORT_BENCHMARK(title, func1, ...)\
-{\
-func1(__VA_ARGS__); /* warm up the cache */ \
-unsigned intlevel = dsp_ENTER_CRITICAL(); \
-uint32_t func1_start = xthal_get_ccount(); \
-func1(__VA_ARGS__); \
-uint32_t func1_end = xthal_get_ccount(); \
-dsp_EXIT_CRITICAL(intlevel); \
-debug.print(title + String(func1_end - func1_start)); \
-}
-#endif
-
 namespace espmath{
-#ifdef CONFIG_IDF_TARGET_ESP32S3
-#if CONFIG_IDF_TARGET_ESP32S3
+#if ESP_MATH_DSP
+
+  /**
+   * @brief Statistics of the n elements of x
+   *
+   * Float elements are summed relative to the first one, so the single
+   * precision sums of the kernel hold their deviations; they are moved
+   * back on double.
+   */
+  static void statsBlock(const float* x, const size_t n, ArrayStats<float>& c, const bool squares)
+  {
+    const float shift = isfinite(x[0]) ? x[0] : 0;
+    float sum = 0, sumsq = 0;
+    dsps_stats_f32_esp(x, &c.min, &c.max, &sum, squares ? &sumsq : NULL, n, 1, shift);
+    c.sum = (double)n*shift + sum;
+    c.sumsq = squares ? (double)sumsq + 2.0*shift*sum + (double)n*shift*shift : 0;
+  }
+
+  static void statsBlock(const int32_t* x, const size_t n, ArrayStats<int32_t>& c, const bool squares)
+  {
+    dsps_stats_s32_esp(x, &c.min, &c.max, &c.sum, squares ? &c.sumsq : NULL, n, 1);
+  }
+
+  static void statsBlock(const int16_t* x, const size_t n, ArrayStats<int16_t>& c, const bool squares)
+  {
+    dsps_stats_s16_esp(x, &c.min, &c.max, &c.sum, squares ? &c.sumsq : NULL, n, 1);
+  }
+
+  static void statsBlock(const int8_t* x, const size_t n, ArrayStats<int8_t>& c, const bool squares)
+  {
+    dsps_stats_s8_esp(x, &c.min, &c.max, &c.sum, squares ? &c.sumsq : NULL, n, 1);
+  }
+
+  /**
+   * @brief Index of the first element equal to value, searched in the block
+   * starting at from, then in the whole array (NaN blocks), len if there is none
+   */
+  template<typename T>
+  static size_t firstIndex(const T* x, const size_t len, const size_t from, const size_t block, const T value)
+  {
+    for (size_t i = from; i < len && i < from + block; i++)
+      if (x[i] == value)
+        return i;
+    for (size_t i = 0; i < len; i++)
+      if (x[i] == value)
+        return i;
+    return len;
+  }
+
+  /**
+   * @brief Statistics of x, chunk by chunk, on both cores when it is long enough
+   *
+   * Every chunk runs in its own critical section; its min, max and sums are
+   * merged into the partial result of its core. To find the indices, and for
+   * float sums, chunks are reduced in blocks: the pass keeps the block where
+   * the first minimum and maximum were found, and only that block is
+   * searched afterwards.
+   */
+  template<typename T>
+  static void reduceParallel(const T* x, const size_t len, ArrayStats<T>& s, const bool squares, const bool indices)
+  {
+    const size_t block = indices || std::is_floating_point<T>::value ? 256 : 0;
+    ArrayStats<T> parts[2];
+    for (ArrayStats<T>& r : parts)
+    {
+      r.min = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+      r.max = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+      r.argmin = r.argmax = len;
+    }
+    execDspChunkedParts(len, [&](const size_t i, const size_t n, const int part)
+    {
+      ArrayStats<T>& r = parts[part];
+      const size_t step = block ? block : n;
+      for (size_t b = i; b < i + n; b += step)
+      {
+        ArrayStats<T> c;
+        statsBlock(x + b, i + n - b < step ? i + n - b : step, c, squares);
+        if (c.min < r.min || (r.argmin == len && c.min == r.min)) {r.min = c.min; r.argmin = b;}
+        if (c.max > r.max || (r.argmax == len && c.max == r.max)) {r.max = c.max; r.argmax = b;}
+        r.sum += c.sum;
+        r.sumsq += c.sumsq;
+      }
+    });
+    /* Part 0 holds the first elements, it wins ties */
+    const ArrayStats<T>& low = parts[0];
+    const ArrayStats<T>& high = parts[1];
+    const ArrayStats<T>& minimum = low.argmin != len && !(high.min < low.min) ? low : high;
+    const ArrayStats<T>& maximum = low.argmax != len && !(high.max > low.max) ? low : high;
+    s.min = minimum.min;
+    s.max = maximum.max;
+    s.argmin = minimum.argmin;
+    s.argmax = maximum.argmax;
+    s.sum = low.sum + high.sum;
+    s.sumsq = low.sumsq + high.sumsq;
+    if (indices && s.argmin != len)
+      s.argmin = firstIndex(x, len, s.argmin, block, s.min);
+    if (indices && s.argmax != len)
+      s.argmax = firstIndex(x, len, s.argmax, block, s.max);
+  }
+
+  static int32_t saturate32(const int64_t value)
+  {
+    return (int32_t)(value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : value));
+  }
+
+  /**
+   * @brief Bits set in the mask words holding the elements [0..len)
+   */
+  static size_t maskCount(const uint32_t* words, const size_t len)
+  {
+    size_t n = 0;
+    for (size_t i = 0; i < (len + 31)/32; i++)
+      n += __builtin_popcount(words[i]);
+    return n;
+  }
+
+  /**
+   * @brief Compare x with a constant into mask, in chunks of whole mask words
+   */
+  template<typename T, typename C>
+  static void compareChunked(esp_err_t (*cmp)(const T*, uint32_t*, int, C, int, int), const T* x, uint32_t* mask, const size_t len, C value, const int op)
+  {
+    execDspChunked(len, [&](const size_t i, const size_t n)
+    {
+      cmp(x + i, mask + i/32, n, value, op, 1);
+    }, 32);
+  }
+
+  /**
+   * @brief Copy the elements of x selected by mask into y, in chunks of whole
+   * mask words
+   *
+   * Each part starts writing after the elements selected before its first
+   * chunk, then moves on by the bits set in every chunk.
+   */
+  template<typename T>
+  static void compressChunked(esp_err_t (*compress)(const T*, const uint32_t*, T*, int), const T* x, const uint32_t* mask, T* y, const size_t len)
+  {
+    size_t next[2] = {SIZE_MAX, SIZE_MAX};
+    size_t offset[2] = {0, 0};
+    execDspChunkedParts(len, [&](const size_t i, const size_t n, const int part)
+    {
+      if (next[part] != i)
+        offset[part] = maskCount(mask, i);
+      compress(x + i, mask + i/32, y + offset[part], n);
+      offset[part] += maskCount(mask + i/32, n);
+      next[part] = i + n;
+    }, 32);
+  }
+
+  /**
+   * @brief y[i] = mask bit i ? x1[i] : x2[i], in chunks of whole mask words
+   */
+  template<typename T>
+  static void selectChunked(esp_err_t (*select)(const T*, const T*, const uint32_t*, T*, int), const T* x1, const T* x2, const uint32_t* mask, T* y, const size_t len)
+  {
+    execDspChunked(len, [&](const size_t i, const size_t n)
+    {
+      select(x1 + i, x2 + i, mask + i/32, y + i, n);
+    }, 32);
+  }
 
   template<>
   Array<float> Array<float>::conv(const Array<float>& kernel)
   {
+    const size_t n = _shape.columns;
+    const size_t k = kernel.shape.columns*kernel.shape.rows;
     shape2D outputShape = shape2D(1, _shape.columns + kernel.shape.columns -1);
     Array<float> convOutput(outputShape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_conv_f32_ae32, _array, _shape.columns, kernel, kernel.shape.columns*kernel.shape.rows, convOutput);
-  #else
-    exec_dsp(dsps_conv_f32_ae32, _array, _shape.columns, kernel, kernel.shape.columns*kernel.shape.rows, convOutput);
-  #endif
+    /* On both cores, the second half of the signal is convolved apart and overlap-added */
+    Array<float> tail;
+    if (parallelism().enabled && n*k >= parallelism().threshold)
+      tail = Array<float>(shape2D(1, n - n/2 + 16 + k));
+    size_t split = 0;
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      if (begin)
+        split = begin;
+      exec_dsp(dsps_conv_f32_ae32, _array + begin, count, kernel, k, begin ? tail.flatten : convOutput.flatten);
+    };
+    if (!tail.flatten || !parallelSplit(n, n*k, 16, job))
+    {
+      job(0, n, 1);
+      return convOutput;
+    }
+    const size_t overlap = k - 1;
+    for (size_t i = 0; i < overlap; i++)
+      convOutput.flatten[split + i] += tail.flatten[i];
+    memcpy(convOutput.flatten + split + overlap, tail.flatten + overlap, (n - split)*sizeof(float));
     return convOutput;
   }
 
   template<>
   Array<float> Array<float>::correlation(const Array<float>& pattern)
   {
+    const size_t n = _shape.columns;
+    const size_t k = pattern.shape.columns*pattern.shape.rows;
     Array<float> corr(_shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_corr_f32_ae32, _array, _shape.columns, pattern, pattern.shape.columns*pattern.shape.rows, corr);
-  #else
-    exec_dsp(dsps_corr_f32_ae32, _array, _shape.columns, pattern, pattern.shape.columns*pattern.shape.rows, corr);
-  #endif
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      exec_dsp(dsps_corr_f32_ae32, _array + begin, count + k - 1, pattern, k, corr.flatten + begin);
+    };
+    const size_t outputs = n >= k ? n - k + 1 : 0;
+    if (!parallelSplit(outputs, outputs*k, 16, job))
+      exec_dsp(dsps_corr_f32_ae32, _array, n, pattern, k, corr);
     return corr;
   }
 
-  Array<float> operator+(const Array<float>& onearray, const Array<float> another)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_add_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_add_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
+  template<>
+  Array<int16_t> Array<int16_t>::conv(const Array<int16_t>& kernel)
+  {
+    /* Convolution is the correlation of the zero padded signal with the reversed kernel */
+    const size_t n = _shape.size;
+    const size_t k = kernel.shape.size;
+    Array<int16_t> convOutput(fracBits, shape2D(1, n && k ? n + k - 1 : 0));
+    if (!convOutput.flatten)
+      return convOutput;
+    Array<int16_t> padded(shape2D(1, n + 2*(k - 1)));
+    Array<int16_t> reversed(shape2D(1, k));
+    if (!padded.flatten || !reversed.flatten)
+      return convOutput;
+    memset(padded.flatten, 0, (k - 1)*sizeof(int16_t));
+    memcpy(padded.flatten + k - 1, _array, n*sizeof(int16_t));
+    memset(padded.flatten + n + k - 1, 0, (k - 1)*sizeof(int16_t));
+    for (size_t i = 0; i < k; i++)
+      reversed.flatten[i] = kernel.flatten[k - 1 - i];
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      exec_dsp(dsps_corr_s16_esp, padded.flatten + begin, count + k - 1, reversed, k, convOutput.flatten + begin, kernel.frac);
+    };
+    if (!parallelSplit(n + k - 1, (n + k - 1)*k, 16, job))
+      job(0, n + k - 1, 1);
+    return convOutput;
   }
 
-  Array<int32_t> operator+(const Array<int32_t>& onearray, const Array<int32_t> another)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_add_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_add_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
+  template<>
+  Array<int16_t> Array<int16_t>::correlation(const Array<int16_t>& pattern)
+  {
+    const size_t n = _shape.size;
+    const size_t k = pattern.shape.size;
+    Array<int16_t> corr(fracBits, shape2D(1, n >= k ? n - k + 1 : 0));
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      exec_dsp(dsps_corr_s16_esp, _array + begin, count + k - 1, pattern, k, corr.flatten + begin, pattern.frac);
+    };
+    if (corr.flatten && !parallelSplit(n - k + 1, (n - k + 1)*k, 16, job))
+      exec_dsp(dsps_corr_s16_esp, _array, n, pattern, k, corr, pattern.frac);
+    return corr;
   }
 
-  Array<uint32_t> operator+(const Array<uint32_t>& onearray, const Array<uint32_t> another)
+  template<>
+  Array<float> Array<float>::matmul(const Array<float>& another) const
   {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ",\
-                    dsps_add_s32_esp,\
-                    (int32_t*)onearray.flatten,\
-                    (int32_t*)another.flatten,\
-                    (int32_t*)newArray.flatten,\
-                    onearray.shape.size);
-  #else
-    exec_dsp(dsps_add_s32_esp,\
-            (int32_t*)onearray.flatten,\
-            (int32_t*)another.flatten,\
-            (int32_t*)newArray.flatten,\
-            onearray.shape.size);
-  #endif
-    return newArray;
+    ESP_ERROR_CHECK(!_shape.canX(another.shape)); //"columns must match the rows of another!"
+    Array<float> product(fracBits, _shape*another.shape);
+    const size_t n = _shape.columns, k = another.shape.columns;
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      exec_dsp(dsps_mmul_f32_esp, _array + begin*n, another, product.flatten + begin*k, count, n, k);
+    };
+    /* Rows of the product on both cores */
+    if (product.flatten && !parallelSplit(_shape.rows, _shape.rows*n*k, 1, job))
+      job(0, _shape.rows, 1);
+    return product;
   }
 
-  Array<int16_t> operator+(const Array<int16_t>& onearray, const Array<int16_t> another)
+  template<>
+  Array<int16_t> Array<int16_t>::matmul(const Array<int16_t>& another) const
   {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_add_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, 0);
-  #else
-    exec_dsp(dsps_add_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, 0);
-  #endif
-    return newArray;
+    ESP_ERROR_CHECK(!_shape.canX(another.shape)); //"columns must match the rows of another!"
+    Array<int16_t> product(fracBits, _shape*another.shape);
+    const size_t n = _shape.columns, k = another.shape.columns;
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      exec_dsp(dsps_mmul_s16_esp, _array + begin*n, another, product.flatten + begin*k, count, n, k, fracBits);
+    };
+    /* Rows of the product on both cores */
+    if (product.flatten && !parallelSplit(_shape.rows, _shape.rows*n*k, 1, job))
+      job(0, _shape.rows, 1);
+    return product;
   }
 
-  Array<int8_t> operator+(const Array<int8_t>& onearray, const Array<int8_t> another)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_add_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_add_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
+  template<>
+  ArrayMask Array<float>::compare(const float value, const Comparison op) const
+  {
+    ArrayMask mask(_shape);
+    if (!mask.words())
+      return mask;
+    if (op == CMP_EQ || op == CMP_NE)
+    {
+      /* Equal within eqFloats tolerance: value - EPSILON <= x <= value + EPSILON */
+      const float EPSILON = 0.0001;
+      ArrayMask upper(_shape);
+      compareChunked(dsps_cmp_f32_esp, _array, mask.words(), _shape.size, value - EPSILON, CMP_GE);
+      compareChunked(dsps_cmp_f32_esp, _array, upper.words(), _shape.size, value + EPSILON, CMP_LE);
+      mask &= upper;
+      return op == CMP_EQ ? mask : ~mask;
+    }
+    compareChunked(dsps_cmp_f32_esp, _array, mask.words(), _shape.size, value, (int)op);
+    return mask;
   }
 
-  Array<float> operator+(const Array<float>& onearray, const float value)
+  template<>
+  ArrayMask Array<int32_t>::compare(const int32_t value, const Comparison op) const
   {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
+    ArrayMask mask(_shape);
+    if (mask.words())
+      compareChunked(dsps_cmp_s32_esp, _array, mask.words(), _shape.size, value, (int)op);
+    return mask;
   }
 
-  Array<int32_t> operator+(const Array<int32_t>& onearray, const int32_t value)
+  template<>
+  ArrayMask Array<int16_t>::compare(const int16_t value, const Comparison op) const
   {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
+    ArrayMask mask(_shape);
+    if (mask.words())
+      compareChunked(dsps_cmp_s16_esp, _array, mask.words(), _shape.size, &value, (int)op);
+    return mask;
   }
 
-  Array<uint32_t> operator+(const Array<uint32_t>& onearray, const uint32_t value)
+  template<>
+  ArrayMask Array<int8_t>::compare(const int8_t value, const Comparison op) const
   {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #endif
-    return newArray;
+    ArrayMask mask(_shape);
+    if (mask.words())
+      compareChunked(dsps_cmp_s8_esp, _array, mask.words(), _shape.size, &value, (int)op);
+    return mask;
   }
 
-  Array<int16_t> operator+(const Array<int16_t>& onearray, const int16_t value)
+  template<>
+  void Array<float>::reduce(ArrayStats<float>& s, const bool squares, const bool indices) const
   {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #else
-    exec_dsp(dsps_addc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #endif
-    return newArray;
+    reduceParallel(_array, _shape.size, s, squares, indices);
   }
 
-  Array<int8_t> operator+(const Array<int8_t>& onearray, const int8_t value)
+  template<>
+  void Array<int32_t>::reduce(ArrayStats<int32_t>& s, const bool squares, const bool indices) const
   {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_addc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
+    reduceParallel(_array, _shape.size, s, squares, indices);
   }
 
-  Array<float> operator+(const float value, const Array<float> onearray)
+  template<>
+  void Array<int16_t>::reduce(ArrayStats<int16_t>& s, const bool squares, const bool indices) const
   {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
+    reduceParallel(_array, _shape.size, s, squares, indices);
   }
 
-  Array<int32_t> operator+(const int32_t value, const Array<int32_t> onearray)
+  template<>
+  void Array<int8_t>::reduce(ArrayStats<int8_t>& s, const bool squares, const bool indices) const
   {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
+    reduceParallel(_array, _shape.size, s, squares, indices);
   }
 
-  Array<uint32_t> operator+(const uint32_t value, const Array<uint32_t> onearray)
+  template<>
+  Array<float> Array<float>::operator[](const ArrayMask& mask) const
   {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_addc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #endif
-    return newArray;
+    assert(mask.size() == _shape.size);
+    Array<float> selected(fracBits, shape2D(1, mask.count()));
+    if (selected.flatten)
+      compressChunked(dsps_compress_s32_esp, (const int32_t*)_array, mask.words(), (int32_t*)selected.flatten, _shape.size);
+    return selected;
   }
 
-  Array<int16_t> operator+(const int16_t value, const Array<int16_t> onearray)
+  template<>
+  Array<int32_t> Array<int32_t>::operator[](const ArrayMask& mask) const
   {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #else
-    exec_dsp(dsps_addc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #endif
-    return newArray;
+    assert(mask.size() == _shape.size);
+    Array<int32_t> selected(fracBits, shape2D(1, mask.count()));
+    if (selected.flatten)
+      compressChunked(dsps_compress_s32_esp, _array, mask.words(), selected.flatten, _shape.size);
+    return selected;
   }
 
-  Array<int8_t> operator+(const int8_t value, const Array<int8_t> onearray)
+  template<>
+  Array<uint32_t> Array<uint32_t>::operator[](const ArrayMask& mask) const
   {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_addc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_addc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
+    assert(mask.size() == _shape.size);
+    Array<uint32_t> selected(fracBits, shape2D(1, mask.count()));
+    if (selected.flatten)
+      compressChunked(dsps_compress_s32_esp, (const int32_t*)_array, mask.words(), (int32_t*)selected.flatten, _shape.size);
+    return selected;
   }
 
-  Array<float> operator-(const Array<float>& onearray, const Array<float> another)
+  template<>
+  Array<int16_t> Array<int16_t>::operator[](const ArrayMask& mask) const
   {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_sub_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_sub_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
+    assert(mask.size() == _shape.size);
+    Array<int16_t> selected(fracBits, shape2D(1, mask.count()));
+    if (selected.flatten)
+      compressChunked(dsps_compress_s16_esp, _array, mask.words(), selected.flatten, _shape.size);
+    return selected;
   }
 
-  Array<int32_t> operator-(const Array<int32_t>& onearray, const Array<int32_t> another)
+  template<>
+  Array<float> where(const ArrayMask& mask, const Array<float>& a, const Array<float>& b)
   {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_sub_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_sub_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
+    assert(a.shape == mask.shape() && b.shape == mask.shape());
+    Array<float> selected(a.frac, a.shape);
+    if (selected.flatten)
+      selectChunked(dsps_select_s32_esp, (const int32_t*)a.flatten, (const int32_t*)b.flatten, mask.words(),\
+                    (int32_t*)selected.flatten, a.shape.size);
+    return selected;
   }
 
-  Array<uint32_t> operator-(const Array<uint32_t>& onearray, const Array<uint32_t> another)
+  template<>
+  Array<int32_t> where(const ArrayMask& mask, const Array<int32_t>& a, const Array<int32_t>& b)
   {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ",\
-                    dsps_sub_s32_esp,\
-                    (int32_t*)onearray.flatten,\
-                    (int32_t*)another.flatten,\
-                    (int32_t*)newArray.flatten,\
-                    onearray.shape.size);
-  #else
-    exec_dsp(dsps_sub_s32_esp,\
-            (int32_t*)onearray.flatten,\
-            (int32_t*)another.flatten,\
-            (int32_t*)newArray.flatten,\
-            onearray.shape.size);
-  #endif
-    return newArray;
+    assert(a.shape == mask.shape() && b.shape == mask.shape());
+    Array<int32_t> selected(a.frac, a.shape);
+    if (selected.flatten)
+      selectChunked(dsps_select_s32_esp, a.flatten, b.flatten, mask.words(), selected.flatten, a.shape.size);
+    return selected;
   }
 
-  Array<int16_t> operator-(const Array<int16_t>& onearray, const Array<int16_t> another)
+  template<>
+  Array<uint32_t> where(const ArrayMask& mask, const Array<uint32_t>& a, const Array<uint32_t>& b)
   {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_sub_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, 0);
-  #else
-    exec_dsp(dsps_sub_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, 0);
-  #endif
-    return newArray;
+    assert(a.shape == mask.shape() && b.shape == mask.shape());
+    Array<uint32_t> selected(a.frac, a.shape);
+    if (selected.flatten)
+      selectChunked(dsps_select_s32_esp, (const int32_t*)a.flatten, (const int32_t*)b.flatten, mask.words(),\
+                    (int32_t*)selected.flatten, a.shape.size);
+    return selected;
   }
 
-  Array<int8_t> operator-(const Array<int8_t>& onearray, const Array<int8_t> another)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_sub_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_sub_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-
-  Array<float> operator-(const Array<float>& onearray, const float value)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("cycles to complete: ", dsps_subc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_subc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int32_t> operator-(const Array<int32_t>& onearray, const int32_t value)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("cycles to complete: ", dsps_subc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_subc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<uint32_t> operator-(const Array<uint32_t>& onearray, const uint32_t value)
-  {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("cycles to complete: ", dsps_subc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_subc_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<int16_t> operator-(const Array<int16_t>& onearray, const int16_t value)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("cycles to complete: ", dsps_subc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #else
-    exec_dsp(dsps_subc_s16_esp, onearray, newArray, onearray.shape.size, &value, 1 , 1, 0);
-  #endif
-    return newArray;
-  }
-
-  Array<int8_t> operator-(const Array<int8_t>& onearray, const int8_t value)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("cycles to complete: ", dsps_subc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_subc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
-  }
-
-  Array<float> operator-(const float value, const Array<float> onearray)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_csub_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_csub_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int32_t> operator-(const int32_t value, const Array<int32_t> onearray)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_csub_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_csub_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<uint32_t> operator-(const uint32_t value, const Array<uint32_t> onearray)
-  {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_csub_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_csub_s32_esp, (int32_t*)onearray.flatten, (int32_t*)newArray.flatten, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int16_t> operator-(const int16_t value, const Array<int16_t> onearray)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_csub_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #else
-    exec_dsp(dsps_csub_s16_esp, onearray, newArray, onearray.shape.size, &value, 1, 1, 0);
-  #endif
-    return newArray;
-  }
-  
-  Array<int8_t> operator-(const int8_t value, const Array<int8_t> onearray)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_csub_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_csub_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
-  }
-  
-  Array<float> operator*(const Array<float>& onearray, const Array<float> another)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mul_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_mul_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<int32_t> operator*(const Array<int32_t>& onearray, const Array<int32_t> another)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mul_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_mul_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<uint32_t> operator*(const Array<uint32_t>& onearray, const Array<uint32_t> another)
-  {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ",\
-                      dsps_mul_s32_esp,\
-                      (int32_t*)onearray.flatten,\
-                      (int32_t*)another.flatten,\
-                      (int32_t*)newArray.flatten,\
-                      onearray.shape.size);
-  #else
-    exec_dsp(dsps_mul_s32_esp,\
-            (int32_t*)onearray.flatten,\
-            (int32_t*)another.flatten,\
-            (int32_t*)newArray.flatten,\
-            onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<int16_t> operator*(const Array<int16_t>& onearray, const Array<int16_t> another)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mul_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_mul_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-  
-  Array<int8_t> operator*(const Array<int8_t>& onearray, const Array<int8_t> another)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mul_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_mul_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<float> operator*(const Array<float>& onearray, const float value)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_mulc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<int32_t> operator*(const Array<int32_t>& onearray, const int32_t value)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_mulc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<uint32_t> operator*(const Array<uint32_t>& onearray, const uint32_t value)
-  {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ",\
-                    dsps_mulc_s32_esp,(int32_t*)onearray.flatten,\
-                    (int32_t*)newArray.flatten,\
-                    onearray.shape.size,\
-                    value);
-  #else
-    exec_dsp(dsps_mulc_s32_esp,(int32_t*)onearray.flatten,\
-                (int32_t*)newArray.flatten,\
-                onearray.shape.size,\
-                value);
-  #endif
-    return newArray;
-  }
-  
-  Array<int16_t> operator*(const Array<int16_t>& onearray, const int16_t value)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_mulc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-  
-  Array<int8_t> operator*(const Array<int8_t>& onearray, const int8_t value)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_mulc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
-  }
-  
-  Array<float> operator*(const float value, const Array<float> onearray)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_mulc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<int32_t> operator*(const int32_t value, const Array<int32_t> onearray)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_mulc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<uint32_t> operator*(const uint32_t value, const Array<uint32_t> onearray)
-  {
-    Array<uint32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ",\
-                    dsps_mulc_s32_esp,(int32_t*)onearray.flatten,\
-                    (int32_t*)newArray.flatten,\
-                    onearray.shape.size,\
-                    value);
-  #else
-    exec_dsp(dsps_mulc_s32_esp,(int32_t*)onearray.flatten,\
-                (int32_t*)newArray.flatten,\
-                onearray.shape.size,\
-                value);
-  #endif
-    return newArray;
-  }
-
-  Array<int16_t> operator*(const int16_t value, const Array<int16_t> onearray)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_mulc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-
-  Array<int8_t> operator*(const int8_t value, const Array<int8_t> onearray)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_mulc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #else
-    exec_dsp(dsps_mulc_s8_esp, onearray, newArray, onearray.shape.size, &value);
-  #endif
-    return newArray;
-  }
-
-  Array<float> operator/(const Array<float>& onearray, const float value)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_divc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_divc_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int32_t> operator/(const Array<int32_t>& onearray, const int32_t value)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_divc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_divc_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int16_t> operator/(const Array<int16_t>& onearray, const int16_t value)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_divc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_divc_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-  
-  Array<int8_t> operator/(const Array<int8_t>& onearray, const int8_t value)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_divc_s8_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_divc_s8_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<float> operator/(const float value, const Array<float> onearray)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_cdiv_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_cdiv_f32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-  
-  Array<int32_t> operator/(const int32_t value, const Array<int32_t> onearray)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_cdiv_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_cdiv_s32_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<int16_t> operator/(const int16_t value, const Array<int16_t> onearray)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_cdiv_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_cdiv_s16_esp, onearray, newArray, onearray.shape.size, value, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-
-  Array<int8_t> operator/(const int8_t value, const Array<int8_t> onearray)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_cdiv_s8_esp, onearray, newArray, onearray.shape.size, value);
-  #else
-    exec_dsp(dsps_cdiv_s8_esp, onearray, newArray, onearray.shape.size, value);
-  #endif
-    return newArray;
-  }
-
-  Array<float> operator/(const Array<float>& onearray, const Array<float> another)
-  {
-    Array<float> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_div_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_div_f32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<int32_t> operator/(const Array<int32_t>& onearray, const Array<int32_t> another)
-  {
-    Array<int32_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_div_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_div_s32_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
-  Array<int16_t> operator/(const Array<int16_t>& onearray, const Array<int16_t> another)
-  {
-    Array<int16_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_div_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_div_s16_esp, onearray, another, newArray, onearray.shape.size, 1, 1, 1, onearray.frac);
-  #endif
-    return newArray;
-  }
-  
-  Array<int8_t> operator/(const Array<int8_t>& onearray, const Array<int8_t> another)
-  {
-    Array<int8_t> newArray(onearray.shape);
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_div_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #else
-    exec_dsp(dsps_div_s8_esp, onearray, another, newArray, onearray.shape.size);
-  #endif
-    return newArray;
-  }
-  
+  template<>
+  Array<int16_t> where(const ArrayMask& mask, const Array<int16_t>& a, const Array<int16_t>& b)
+  {
+    assert(a.shape == mask.shape() && b.shape == mask.shape());
+    Array<int16_t> selected(a.frac, a.shape);
+    if (selected.flatten)
+      selectChunked(dsps_select_s16_esp, a.flatten, b.flatten, mask.words(), selected.flatten, a.shape.size);
+    return selected;
+  }
+
+  namespace kernels{
+
+    void add(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_f32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void add(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void add(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_s32_esp((const int32_t*)(x1 + i*step_x1), (const int32_t*)(x2 + i*step_x2), (int32_t*)(y + i*step_y), n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void add(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_s16_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, 0);
+      });
+    }
+
+    void add(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_s8_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void addc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_addc_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void addc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_addc_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void addc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_addc_s32_esp((const int32_t*)(x + i*step_x), (int32_t*)(y + i*step_y), n, c, step_x, step_y);
+      });
+    }
+
+    void addc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_addc_s16_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y, 0);
+      });
+    }
+
+    void addc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_addc_s8_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y);
+      });
+    }
+
+    void sub(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_f32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void sub(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void sub(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_s32_esp((const int32_t*)(x1 + i*step_x1), (const int32_t*)(x2 + i*step_x2), (int32_t*)(y + i*step_y), n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void sub(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_s16_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, 0);
+      });
+    }
+
+    void sub(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_s8_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void subc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_subc_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void subc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_subc_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void subc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_subc_s32_esp((const int32_t*)(x + i*step_x), (int32_t*)(y + i*step_y), n, c, step_x, step_y);
+      });
+    }
+
+    void subc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_subc_s16_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y, 0);
+      });
+    }
+
+    void subc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_subc_s8_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y);
+      });
+    }
+
+    void csub(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_csub_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void csub(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_csub_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void csub(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_csub_s32_esp((const int32_t*)(x + i*step_x), (int32_t*)(y + i*step_y), n, c, step_x, step_y);
+      });
+    }
+
+    void csub(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_csub_s16_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y, 0);
+      });
+    }
+
+    void csub(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_csub_s8_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y);
+      });
+    }
+
+    void mul(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mul_f32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void mul(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (frac)
+          dsps_mul_fixed_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac);
+        else
+          dsps_mul_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void mul(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mul_s32_esp((const int32_t*)(x1 + i*step_x1), (const int32_t*)(x2 + i*step_x2), (int32_t*)(y + i*step_y), n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void mul(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      const FixedArithmetic arithmetic = fixedArithmetic();
+      const int mode = arithmetic.mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (arithmetic.plain())
+          dsps_mul_s16_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac);
+        else
+          dsps_mul_s16_mode_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac, mode);
+      });
+    }
+
+    void mul(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mul_s8_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void mulc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mulc_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void mulc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (frac)
+          dsps_mulc_fixed_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        else
+          dsps_mulc_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void mulc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mulc_s32_esp((const int32_t*)(x + i*step_x), (int32_t*)(y + i*step_y), n, c, step_x, step_y);
+      });
+    }
+
+    void mulc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      const FixedArithmetic arithmetic = fixedArithmetic();
+      const int mode = arithmetic.mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (arithmetic.plain())
+          dsps_mulc_s16_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        else
+          dsps_mulc_s16_mode_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac, mode);
+      });
+    }
+
+    void mulc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_mulc_s8_esp(x + i*step_x, y + i*step_y, n, &c, step_x, step_y);
+      });
+    }
+
+    void divc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_divc_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void divc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      dsps_divc_magic_t magic;
+      if (frac)
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_fixed_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        });
+      }
+      else if (dsps_divc_magic(c, &magic))
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_magic_s32_esp(x + i*step_x, y + i*step_y, n, &magic, step_x, step_y);
+        });
+      }
+      else
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+        });
+      }
+    }
+
+    void divc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      dsps_divc_magic_t magic;
+      const FixedArithmetic arithmetic = fixedArithmetic();
+      if (!arithmetic.plain())
+      {
+        const int mode = arithmetic.mode();
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_s16_mode_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac, mode);
+        });
+      }
+      else if (dsps_divc_magic(c, &magic))
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_magic_s16_esp(x + i*step_x, y + i*step_y, n, &magic, step_x, step_y, frac);
+        });
+      }
+      else
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_s16_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        });
+      }
+    }
+
+    void divc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      dsps_divc_magic_t magic;
+      if (dsps_divc_magic(c, &magic))
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_magic_s8_esp(x + i*step_x, y + i*step_y, n, &magic, step_x, step_y);
+        });
+      }
+      else
+      {
+        execDspChunked(len, [&](const size_t i, const size_t n)
+        {
+          dsps_divc_s8_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+        });
+      }
+    }
+
+    void cdiv(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_cdiv_f32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void cdiv(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (frac)
+          dsps_cdiv_fixed_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        else
+          dsps_cdiv_s32_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void cdiv(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      const FixedArithmetic arithmetic = fixedArithmetic();
+      const int mode = arithmetic.mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (arithmetic.plain())
+          dsps_cdiv_s16_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac);
+        else
+          dsps_cdiv_s16_mode_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y, frac, mode);
+      });
+    }
+
+    void cdiv(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_cdiv_s8_esp(x + i*step_x, y + i*step_y, n, c, step_x, step_y);
+      });
+    }
+
+    void div(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_div_f32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void div(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (frac)
+          dsps_div_fixed_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac);
+        else
+          dsps_div_s32_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void div(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      const FixedArithmetic arithmetic = fixedArithmetic();
+      const int mode = arithmetic.mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        if (arithmetic.plain())
+          dsps_div_s16_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac);
+        else
+          dsps_div_s16_mode_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, frac, mode);
+      });
+    }
+
+    void div(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1, const int step_x2, const int step_y)
+    {
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_div_s8_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y);
+      });
+    }
+
+    void add(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1, const int step_x2, const int step_y)
+    {
+      if (formats.same())
+        return add(x1, x2, y, len, formats.y, step_x1, step_x2, step_y);
+      const int mode = fixedArithmetic().mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_add_s16_q_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, formats.x1, formats.x2, formats.y, mode);
+      });
+    }
+
+    void sub(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1, const int step_x2, const int step_y)
+    {
+      if (formats.same())
+        return sub(x1, x2, y, len, formats.y, step_x1, step_x2, step_y);
+      const int mode = fixedArithmetic().mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        dsps_sub_s16_q_esp(x1 + i*step_x1, x2 + i*step_x2, y + i*step_y, n, step_x1, step_x2, step_y, formats.x1, formats.x2, formats.y, mode);
+      });
+    }
+
+    /* x1*x2 is in Q(x1 + x2): a right shift into Q(y) is a plain product kernel */
+    void mul(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1, const int step_x2, const int step_y)
+    {
+      const int shift = formats.x1 + formats.x2 - formats.y;
+      if (shift >= 0 && shift <= 15)
+        return mul(x1, x2, y, len, (uint8_t)shift, step_x1, step_x2, step_y);
+      const int mode = fixedArithmetic().mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        for (size_t k = i; k < i + n; k++)
+          y[k*step_y] = dsps_fixed_mul_q_s16(x1[k*step_x1], formats.x1, x2[k*step_x2], formats.x2, formats.y, mode);
+      });
+    }
+
+    /* (x1 << frac)/x2 is in Q(x1 + frac - x2): frac = y + x2 - x1 is a plain quotient kernel */
+    void div(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1, const int step_x2, const int step_y)
+    {
+      const int shift = formats.y + formats.x2 - formats.x1;
+      if (shift >= 0 && shift <= 15)
+        return div(x1, x2, y, len, (uint8_t)shift, step_x1, step_x2, step_y);
+      const int mode = fixedArithmetic().mode();
+      execDspChunked(len, [&](const size_t i, const size_t n)
+      {
+        for (size_t k = i; k < i + n; k++)
+          y[k*step_y] = dsps_fixed_div_q_s16(x1[k*step_x1], formats.x1, x2[k*step_x2], formats.x2, formats.y, mode);
+      });
+    }
+  }
+
+  /* Dot products run chunk by chunk, one partial sum per core */
   float operator^(const Array<float>& onearray, const Array<float> another)
   {
-    float result;
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_dotp_f32_esp, onearray, another, &result, onearray.shape.size);
-  #else
-    exec_dsp(dsps_dotp_f32_esp, onearray, another, &result, onearray.shape.size);
-  #endif
-    return result;
+    float sums[2] = {0, 0};
+    execDspChunkedParts(onearray.shape.size, [&](const size_t i, const size_t n, const int part)
+    {
+      float sum;
+      dsps_dotp_f32_esp(onearray.flatten + i, another.flatten + i, &sum, n);
+      sums[part] += sum;
+    });
+    return sums[0] + sums[1];
   }
 
   int32_t operator^(const Array<int32_t>& onearray, const Array<int32_t> another)
   {
-    int32_t result;
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_dotp_s32_esp, onearray, another, &result, onearray.shape.size);
-  #else
-    exec_dsp(dsps_dotp_s32_esp, onearray, another, &result, onearray.shape.size);
-  #endif
-    return result;
+    int64_t sums[2] = {0, 0};
+    execDspChunkedParts(onearray.shape.size, [&](const size_t i, const size_t n, const int part)
+    {
+      dsps_dotp_s32_acc_esp(onearray.flatten + i, another.flatten + i, &sums[part], n);
+    });
+    return saturate32((sums[0] + sums[1]) >> onearray.frac);
   }
-  
-  int16_t operator^(const Array<int16_t>& onearray, const Array<int16_t> another)
+
+  int32_t operator^(const Array<int16_t>& onearray, const Array<int16_t> another)
   {
-    int16_t result;
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_dotp_s16_esp, onearray, another, &result, onearray.shape.size, 1, 1, onearray.frac);
-  #else
-    exec_dsp(dsps_dotp_s16_esp, onearray, another, &result, onearray.shape.size, 1, 1, onearray.frac);
-  #endif
-    return result;
+    int64_t sums[2] = {0, 0};
+    execDspChunkedParts(onearray.shape.size, [&](const size_t i, const size_t n, const int part)
+    {
+      dsps_dotpw_s16_acc_esp(onearray.flatten + i, another.flatten + i, &sums[part], n);
+    });
+    return saturate32((sums[0] + sums[1]) >> onearray.frac);
   }
 
-  int8_t operator^(const Array<int8_t>& onearray, const Array<int8_t> another)
+  int32_t operator^(const Array<int8_t>& onearray, const Array<int8_t> another)
   {
-    int8_t result;
-  #if defined BENCHMARK_TEST
-    REPORT_BENCHMARK("Cycles to complete: ", dsps_dotp_s8_esp, onearray, another, &result, onearray.shape.size);
-  #else
-    exec_dsp(dsps_dotp_s8_esp, onearray, another, &result, onearray.shape.size);
-  #endif
-    return result;
+    int64_t sums[2] = {0, 0};
+    execDspChunkedParts(onearray.shape.size, [&](const size_t i, const size_t n, const int part)
+    {
+      dsps_dotp_s8_acc_esp(onearray.flatten + i, another.flatten + i, &sums[part], n);
+    });
+    return saturate32(sums[0] + sums[1]);
   }
 
-#endif
 #endif
 }
\ No newline at end of file
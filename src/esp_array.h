@@ -1,19 +1,17 @@
 #ifndef _ESP_ARRAY_H_
 #define _ESP_ARRAY_H_
 
-#include <Arduino.h>
+#include "esp_platform.h"
 #include <type_traits>
-#include <esp_err.h>
-
-#include "dsps_conv.h"
-#include "dsps_corr.h"
-#include "dsps_dotprod.h"
+#include <utility>
+#include <limits>
 
 #include "esp_opt.h"
 #include "esp_dsp.h"
 #include "esp_ansi.h"
 
 #include "esp_fixed_point.h"
+#include "esp_expression.h"
 
 /**
  * @brief Namespace for custom ESP32 MATH libraries
@@ -66,7 +64,385 @@ namespace espmath{
      */
     shape2D operator*(const shape2D& another)const{return shape2D(this->rows, another.columns);}
   };
-  
+
+  /**
+   * @brief Non-owning view over evenly spaced elements of an array.
+   *
+   * A view is a pointer, a length, a stride and the fractional bits of the
+   * elements. It never allocates nor frees memory, so it must not outlive the
+   * array it was taken from (see Array::view, Array::row, Array::column and
+   * Array::slice).
+   *
+   * Views take part in the arithmetic operators as any Array does and are
+   * handed to the DSP kernels through their step arguments, so a column of a
+   * matrix or every n-th sample of a signal is processed without being copied:
+   *
+   * Array<float> energy = signal.slice(0, n/4, 4) * signal.slice(0, n/4, 4);
+   * matrix.column(2) = matrix.column(0) + matrix.column(1);
+   *
+   * Contiguous views that do not start on an ALIGNMENT boundary, such as
+   * slice(1, n - 1) or the rows of a matrix whose rows are not a multiple of
+   * 16 bytes, cannot use the vector loops of the kernels and are evaluated
+   * element by element.
+   *
+   * @note Assigning to a view writes through it into the viewed array.
+   * Assigning overlapping views of the same array is undefined.
+   *
+   * @tparam T Array type
+   */
+  template <typename T> class ArrayView : public ArrayExpressionBase
+  {
+  public:
+    typedef T value_type;
+
+    /**
+     * @brief Construct a new ArrayView object
+     *
+     * @param data First element.
+     * @param length Number of elements.
+     * @param stride Distance, in elements, between two consecutive elements.
+     * @param frac Fractional bits of a fixed point array.
+     */
+    ArrayView(T* data, const size_t length, const size_t stride = 1, const uint8_t frac = 0):\
+      _data(data),_shape(1, length),_stride(stride),fracBits(frac){}
+
+    ArrayView(const ArrayView& another):ArrayView(another._data, another.length(), another._stride, another.fracBits){}
+
+    /**
+     * @brief Copy the elements of another view into the viewed elements
+     *
+     * @param another View of the same length
+     * @return ArrayView&
+     */
+    ArrayView& operator=(const ArrayView& another)
+    {
+      assert(another.length() == length());
+      evaluate(another, _data, _stride);
+      return *this;
+    }
+
+    /**
+     * @brief Evaluate an expression into the viewed elements
+     *
+     * @param expression Arithmetic between arrays and views of the same length.
+     * @return ArrayView&
+     */
+    template<class E>
+    typename std::enable_if<std::is_base_of<ArrayExpressionBase, E>::value &&\
+                            std::is_same<typename E::value_type, T>::value, ArrayView&>::type
+    operator=(const E& expression)
+    {
+      assert(expression.shape().size == length());
+      evaluate(expression, _data, _stride);
+      return *this;
+    }
+
+    /**
+     * @brief Get the i-th element of the view
+     *
+     * @param i
+     * @return T&
+     */
+    T& operator[](const size_t i) const {return _data[i*_stride];}
+
+    /**
+     * @brief Take a view of a part of the view
+     *
+     * @param start Index of the first element.
+     * @param length Number of elements.
+     * @param step Take one element out of step, e.g. 2 decimates by two.
+     * @return ArrayView
+     */
+    ArrayView slice(const size_t start, const size_t length, const size_t step = 1) const
+    {
+      assert(length == 0 || start + (length - 1)*step < this->length());
+      return ArrayView(_data + start*_stride, length, _stride*step, fracBits);
+    }
+
+    T* data() const {return _data;}
+    size_t stride() const {return _stride;}
+    size_t length() const {return _shape.columns;}
+    const shape2D& shape() const {return _shape;}
+    uint8_t frac() const {return fracBits;}
+
+  private:
+    T* _data;
+    shape2D _shape;
+    size_t _stride;
+    uint8_t fracBits;
+  };
+
+  /**
+   * @brief Comparison between the elements of an array and a value.
+   *
+   * The values are the DSPS_CMP_* codes taken by the dsps_cmp_* kernels.
+   */
+  enum Comparison
+  {
+    CMP_EQ = 0, /* element == value */
+    CMP_NE = 1, /* element != value */
+    CMP_LT = 2, /* element <  value */
+    CMP_GE = 3, /* element >= value */
+    CMP_GT = 4, /* element >  value */
+    CMP_LE = 5  /* element <= value */
+  };
+
+  /**
+   * @brief Packed boolean array, one bit per element.
+   *
+   * This is what the comparison operators of Array return, e.g.
+   *
+   * ArrayMask hot = temperature > 80;
+   * if (hot.any()) ...
+   * size_t n = (temperature > 20 & temperature < 30).count();
+   *
+   * Element i is bit i%32 of word i/32, so a mask takes 1/8 of a byte per
+   * element whatever the type of the compared array. The bits of the last
+   * word past the size are always clear.
+   */
+  class ArrayMask
+  {
+  public:
+    /**
+     * @brief Construct a new ArrayMask object, every element false
+     *
+     * @param initialShape Shape of the compared array.
+     */
+    ArrayMask(const shape2D initialShape = shape2D(1,0)):_shape(initialShape)
+    {
+      _words = allocate(wordCount());
+    }
+
+    ArrayMask(const ArrayMask& another):ArrayMask(another._shape)
+    {
+      if (_words)
+        memcpy(_words, another._words, wordCount()*sizeof(uint32_t));
+    }
+
+    ArrayMask(ArrayMask&& another) noexcept:_words(another._words),_shape(another._shape)
+    {
+      another._words = NULL;
+      another._shape = shape2D(1,0);
+    }
+
+    ~ArrayMask()
+    {
+      if (_words)
+        heap_caps_free(_words);
+    }
+
+    ArrayMask& operator=(const ArrayMask& another)
+    {
+      if (this != &another)
+      {
+        ArrayMask copy(another);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+
+    ArrayMask& operator=(ArrayMask&& another) noexcept
+    {
+      if (this != &another)
+      {
+        if (_words)
+          heap_caps_free(_words);
+        _words = another._words;
+        _shape = another._shape;
+        another._words = NULL;
+        another._shape = shape2D(1,0);
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Get the i-th element of the mask
+     *
+     * @param i
+     * @return bool
+     */
+    bool operator[](const size_t i) const {return (_words[i/32] >> (i%32)) & 1;}
+
+    /**
+     * @brief Set the i-th element of the mask
+     *
+     * @param i
+     * @param value
+     */
+    void set(const size_t i, const bool value)
+    {
+      if (value)
+        _words[i/32] |= (uint32_t)1 << (i%32);
+      else
+        _words[i/32] &= ~((uint32_t)1 << (i%32));
+    }
+
+    /**
+     * @brief Verify if any element is true
+     *
+     * @return true At least one element is true.
+     * @return false Every element is false, or the mask is empty.
+     */
+    bool any() const
+    {
+      for (size_t i = 0; i < wordCount(); i++)
+        if (_words[i])
+          return true;
+      return false;
+    }
+
+    /**
+     * @brief Verify if every element is true
+     *
+     * @return true Every element is true, or the mask is empty.
+     * @return false At least one element is false.
+     */
+    bool all() const
+    {
+      const size_t full = _shape.size/32;
+      for (size_t i = 0; i < full; i++)
+        if (_words[i] != UINT32_MAX)
+          return false;
+      return _shape.size % 32 == 0 || _words[full] == lastWordBits();
+    }
+
+    /**
+     * @brief Count the true elements
+     *
+     * @return size_t
+     */
+    size_t count() const
+    {
+      size_t n = 0;
+      for (size_t i = 0; i < wordCount(); i++)
+        n += __builtin_popcount(_words[i]);
+      return n;
+    }
+
+    /**
+     * @brief Element-wise and of two masks of the same shape
+     *
+     * @param another
+     * @return ArrayMask&
+     */
+    ArrayMask& operator&=(const ArrayMask& another)
+    {
+      assert(another._shape == _shape);
+      for (size_t i = 0; i < wordCount(); i++)
+        _words[i] &= another._words[i];
+      return *this;
+    }
+
+    /**
+     * @brief Element-wise or of two masks of the same shape
+     *
+     * @param another
+     * @return ArrayMask&
+     */
+    ArrayMask& operator|=(const ArrayMask& another)
+    {
+      assert(another._shape == _shape);
+      for (size_t i = 0; i < wordCount(); i++)
+        _words[i] |= another._words[i];
+      return *this;
+    }
+
+    /**
+     * @brief Element-wise exclusive or of two masks of the same shape
+     *
+     * @param another
+     * @return ArrayMask&
+     */
+    ArrayMask& operator^=(const ArrayMask& another)
+    {
+      assert(another._shape == _shape);
+      for (size_t i = 0; i < wordCount(); i++)
+        _words[i] ^= another._words[i];
+      return *this;
+    }
+
+    ArrayMask operator&(const ArrayMask& another) const {ArrayMask result(*this); result &= another; return result;}
+    ArrayMask operator|(const ArrayMask& another) const {ArrayMask result(*this); result |= another; return result;}
+    ArrayMask operator^(const ArrayMask& another) const {ArrayMask result(*this); result ^= another; return result;}
+
+    /**
+     * @brief Element-wise not
+     *
+     * @return ArrayMask
+     */
+    ArrayMask operator~() const
+    {
+      ArrayMask result(*this);
+      for (size_t i = 0; i < wordCount(); i++)
+        result._words[i] = ~_words[i];
+      if (_shape.size % 32)
+        result._words[wordCount() - 1] &= lastWordBits();
+      return result;
+    }
+
+    /**
+     * @brief Get the packed elements, (size + 31)/32 words
+     *
+     * @return uint32_t*
+     */
+    uint32_t* words() const {return _words;}
+    size_t wordCount() const {return (_shape.size + 31)/32;}
+    size_t size() const {return _shape.size;}
+    const shape2D& shape() const {return _shape;}
+
+  private:
+    uint32_t* _words = NULL;
+    shape2D _shape;
+
+    /**
+     * @brief Bits of the last word that hold elements, when it is not full
+     */
+    uint32_t lastWordBits() const {return ((uint32_t)1 << (_shape.size % 32)) - 1;}
+
+    /**
+     * @brief Allocate n zeroed words
+     *
+     * @param n
+     * @return uint32_t* NULL if n is 0 or the allocation failed
+     */
+    static uint32_t* allocate(const size_t n)
+    {
+      if (!n)
+        return NULL;
+      uint32_t* words = (uint32_t*)heap_caps_aligned_alloc(ALIGNMENT, n*sizeof(uint32_t), MALLOC_CAP_32BIT);
+      if (words)
+        memset(words, 0, n*sizeof(uint32_t));
+      return words;
+    }
+  };
+
+  /**
+   * @brief Summary statistics of an array, see Array::stats.
+   *
+   * The statistics are computed on the stored elements. For fixed point
+   * arrays, divide sum, mean and norm2 by 2^frac, sumsq and var by 4^frac
+   * to get real values.
+   *
+   * @tparam T Array type
+   */
+  template<typename T> struct ArrayStats
+  {
+    /* Accumulator of the kernels: int64_t for integer arrays, float for float arrays */
+    typedef typename std::conditional<std::is_floating_point<T>::value, float, int64_t>::type sum_t;
+    /* Type of sum and sumsq: int64_t for integer arrays, double for float arrays */
+    typedef typename std::conditional<std::is_floating_point<T>::value, double, int64_t>::type total_t;
+
+    T min;
+    T max;
+    size_t argmin = 0; /* Index of the first smallest element */
+    size_t argmax = 0; /* Index of the first largest element */
+    total_t sum = 0;
+    total_t sumsq = 0; /* Sum of squares */
+    float mean = 0;
+    float var = 0;   /* Population variance */
+    float norm2 = 0; /* Euclidean norm */
+  };
+
   /**
    * @brief Custom Array implementation suitable for ESP32 devices.
    * 
@@ -82,6 +458,7 @@ namespace espmath{
   {
   public:
     typedef T* const arrayPntr;
+    typedef T value_type;
 
     static bool isDSPSupported(){return false;}
 
@@ -107,8 +484,8 @@ namespace espmath{
       if (capabilities != UINT32_MAX)
         _caps = capabilities;
       _shape = initialShape;
-      _size = _mem2alloc(_shape.columns);
-      _array = _size > 0 ? (T*)heap_caps_aligned_alloc(ALIGNMENT, _size, _caps) : NULL;
+      _size = _mem2alloc(_shape.size);
+      _array = allocate(_size);
       if(!_array)
         _size = 0;
     }
@@ -139,7 +516,7 @@ namespace espmath{
           const uint32_t capabilities = UINT32_MAX):Array(initialShape, capabilities)
     {
       if (_array && initialValues)
-        cpyArray(initialValues, _array, _shape.columns);
+        cpyArray(initialValues, _array, _shape.size);
     }
 
     /**
@@ -154,8 +531,8 @@ namespace espmath{
           const uint32_t capabilities = UINT32_MAX):Array(initialShape, capabilities)
     {
       fracBits = initialValues.frac;
-      if (_array && initialValues)
-        cpyArray(initialValues.data, _array, _shape.columns);
+      if (_array && initialValues.data)
+        cpyArray(initialValues.data, _array, _shape.size);
     }
 
     /**
@@ -172,7 +549,7 @@ namespace espmath{
       fracBits = initialValues[0].frac;
       if (_array && initialValues)
       {
-        for (int i = 0; i < _shape.columns; i++)
+        for (size_t i = 0; i < _shape.size; i++)
           _array[i] = initialValues[i].data;
       }
     }
@@ -183,15 +560,107 @@ namespace espmath{
      * @param another 
      */
     Array(const Array& another){copy(another);}
-    Array(const Array&& another){copy(another);}
+
+    /**
+     * @brief Move constructor. Takes over the buffer of another array,
+     * which is left empty.
+     * 
+     * @param another 
+     */
+    Array(Array&& another) noexcept:_array(another._array),\
+                                    _size(another._size),\
+                                    _shape(another._shape),\
+                                    _caps(another._caps),\
+                                    fracBits(another.fracBits),\
+                                    canBeDestroyed(another.canBeDestroyed)
+    {
+      another.release();
+    }
+
+    /**
+     * @brief Construct a new Array object evaluating an expression
+     * 
+     * @param expression Arithmetic between arrays, e.g. a*b + c.
+     */
+    template<class E, typename std::enable_if<std::is_base_of<ArrayExpressionBase, E>::value &&\
+                                              std::is_same<typename E::value_type, T>::value, int>::type = 0>
+    Array(const E& expression):Array(expression.shape())
+    {
+      fracBits = expression.frac();
+      if (_array)
+        evaluate(expression, _array);
+    }
 
     /**
      * @brief Assign operation
      * 
      * @param another 
      */
-    void operator=(const Array& another){copy(another);}
-    void operator=(Array&& another){copyRef(another);}
+    Array& operator=(const Array& another)
+    {
+      copy(another);
+      return *this;
+    }
+
+    /**
+     * @brief Move assignment. Frees the current buffer and takes over
+     * the buffer of another array, which is left empty.
+     * 
+     * @param another 
+     */
+    Array& operator=(Array&& another) noexcept
+    {
+      if (this == &another)
+        return *this;
+
+      if (canBeDestroyed && _array)
+        heap_caps_free(_array);
+
+      _array = another._array;
+      _size = another._size;
+      _shape = another._shape;
+      _caps = another._caps;
+      fracBits = another.fracBits;
+      canBeDestroyed = another.canBeDestroyed;
+      another.release();
+      return *this;
+    }
+
+    /**
+     * @brief Evaluate an expression into the array
+     * 
+     * The current buffer is reused when it is large enough,
+     * so a = a*b + c does not allocate.
+     * 
+     * @param expression Arithmetic between arrays, e.g. a*b + c.
+     */
+    template<class E>
+    typename std::enable_if<std::is_base_of<ArrayExpressionBase, E>::value &&\
+                            std::is_same<typename E::value_type, T>::value, Array&>::type
+    operator=(const E& expression)
+    {
+      const shape2D& newShape = expression.shape();
+      const size_t newSize = _mem2alloc(newShape.size);
+
+      if (!canBeDestroyed || newSize > _size)
+      {
+        /* The expression may still read the old buffer */
+        T* newArray = allocate(newSize);
+        if (newArray)
+          evaluate(expression, newArray);
+        if (canBeDestroyed && _array)
+          heap_caps_free(_array);
+        _array = newArray;
+        _size = newArray ? newSize : 0;
+        canBeDestroyed = true;
+      }
+      else if (_array)
+        evaluate(expression, _array);
+
+      fracBits = expression.frac();
+      _shape = newShape;
+      return *this;
+    }
 
     /**
      * @brief Get array element
@@ -218,159 +687,114 @@ namespace espmath{
      * 
      * array[filter] -> {2,4,5}.
      * 
-     * @param filter The array filter
+     * @param filter The array filter, of the size of the array
      * @return Array
      */
-    Array operator[](const Array filter)
+    Array operator[](const Array& filter) const
     {
-      Array<T> newArray();
-      for (size_t i = 0; i < _shape.columns; i++)
-        if(filter.flatten[i]) newArray << _array[i];
-      return newArray;
+      return (*this)[filter.compare(0, CMP_NE)];
     }
 
     /**
-     * @brief Get the boolean array indicating where the value is the same as the element.
+     * @brief Select the elements where the mask is true (stream compaction).
      * 
-     * @param value The value to be verified.
-     * @return Array.
+     * Example:
+     * array = {1, 2, 3, 4, 5};
+     * 
+     * array[array > 2] -> {3,4,5}.
+     * 
+     * The result is allocated once, with mask.count() elements, and filled
+     * in a single pass.
+     * 
+     * @param mask Mask of the size of the array
+     * @return Array
+     * @note float, int32_t and int16_t arrays make use of DSP instructions.
      */
-    Array operator==(const T value)
+    Array operator[](const ArrayMask& mask) const
     {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] == value;
-      
-      return newArray;
+      assert(mask.size() == _shape.size);
+      Array<T> selected(fracBits, shape2D(1, mask.count()));
+      size_t j = 0;
+      for (size_t i = 0; selected.flatten && i < _shape.size; i++)
+        if (mask[i]) selected.flatten[j++] = _array[i];
+      return selected;
     }
 
-    Array operator==(const fixed value)
+    /**
+     * @brief Compare every element with a value
+     * 
+     * Example:
+     * array = {1, 2, 3, 4, 5};
+     * 
+     * array.compare(3, CMP_GT) -> {0, 0, 0, 1, 1}.
+     * 
+     * @param value The value to be compared.
+     * @param op The comparison.
+     * @return ArrayMask of the shape of the array.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     * Float elements are equal to the value within eqFloats tolerance.
+     */
+    ArrayMask compare(const T value, const Comparison op) const
     {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] == value.data;
-      return newArray;
+      ArrayMask mask(_shape);
+      for (size_t i = 0; mask.words() && i < _shape.size; i++)
+        if (compareValues(_array[i], value, op)) mask.set(i, true);
+      return mask;
     }
 
     /**
-     * @brief Get the boolean array indicating where the value is different than the element.
+     * @brief Get the mask indicating where the value is the same as the element.
      * 
      * @param value The value to be verified.
-     * @return Array.
+     * @return ArrayMask.
      */
-    Array operator!=(const T value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] != value;
-      
-      return newArray;
-    }
-
-    Array operator!=(const fixed value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] != value.data;
-      
-      return newArray;
-    }
+    ArrayMask operator==(const T value) const {return compare(value, CMP_EQ);}
+    ArrayMask operator==(const fixed value) const {return compare((T)value.data, CMP_EQ);}
 
     /**
-     * @brief Get the boolean array indicating where the value is greater than the element.
+     * @brief Get the mask indicating where the value is different than the element.
      * 
      * @param value The value to be verified.
-     * @return Array.
+     * @return ArrayMask.
      */
-    Array operator>(const T value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] > value;
-      
-      return newArray;
-    }
-
-    Array operator>(const fixed value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] > value.data;
-      
-      return newArray;
-    }
+    ArrayMask operator!=(const T value) const {return compare(value, CMP_NE);}
+    ArrayMask operator!=(const fixed value) const {return compare((T)value.data, CMP_NE);}
 
     /**
-     * @brief Get the boolean array indicating where the value is less than the element.
+     * @brief Get the mask indicating where the element is greater than the value.
      * 
      * @param value The value to be verified.
-     * @return Array.
+     * @return ArrayMask.
      */
-    Array operator<(const T value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] < value;
-      
-      return newArray;
-    }
-
-    Array operator<(const fixed value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] < value.data;
-      
-      return newArray;
-    }
+    ArrayMask operator>(const T value) const {return compare(value, CMP_GT);}
+    ArrayMask operator>(const fixed value) const {return compare((T)value.data, CMP_GT);}
 
     /**
-     * @brief Get the boolean array indicating where the value is greater or equal to the element.
+     * @brief Get the mask indicating where the element is less than the value.
      * 
      * @param value The value to be verified.
-     * @return Array.
+     * @return ArrayMask.
      */
-    Array operator>=(const T value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] >= value;
-      
-      return newArray;
-    }
+    ArrayMask operator<(const T value) const {return compare(value, CMP_LT);}
+    ArrayMask operator<(const fixed value) const {return compare((T)value.data, CMP_LT);}
 
-    Array operator>=(const fixed value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] >= value.data;
-      
-      return newArray;
-    }
+    /**
+     * @brief Get the mask indicating where the element is greater than or equal to the value.
+     * 
+     * @param value The value to be verified.
+     * @return ArrayMask.
+     */
+    ArrayMask operator>=(const T value) const {return compare(value, CMP_GE);}
+    ArrayMask operator>=(const fixed value) const {return compare((T)value.data, CMP_GE);}
 
     /**
-     * @brief Get the boolean array indicating where the value is less or equal to the element.
+     * @brief Get the mask indicating where the element is less than or equal to the value.
      * 
      * @param value The value to be verified.
-     * @return Array.
+     * @return ArrayMask.
      */
-    Array operator<=(const T value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] <= value;
-      
-      return newArray;
-    }
-
-    Array operator<=(const fixed value) const
-    {
-      Array<T> newArray(_shape);
-      for (size_t i = 0; i < _shape.size; i++)
-        newArray.flatten[i] = _array[i] <= value.data;
-      
-      return newArray;
-    }
+    ArrayMask operator<=(const T value) const {return compare(value, CMP_LE);}
+    ArrayMask operator<=(const fixed value) const {return compare((T)value.data, CMP_LE);}
 
     /**
      * @brief copy.flatten[i] = !array.flatten[i], i = 0,1,2,3...
@@ -407,7 +831,7 @@ namespace espmath{
      * @return true Every value of the _array is contained in input.
      * @return false Not all values of the _array are contained in input.
      */
-    bool operator==(const T* input)
+    bool operator==(const T* input) const
     {
       size_t i = 0;
       while( i < _shape.size)
@@ -419,7 +843,7 @@ namespace espmath{
       return true;
     }
 
-    bool operator==(const fixed* input)
+    bool operator==(const fixed* input) const
     {
       size_t i = 0;
       while( i < _shape.size)
@@ -438,12 +862,12 @@ namespace espmath{
      * @return true Every value of the _array is contained in input.
      * @return false Not all values of the _array are contained in input.
      */
-    bool operator==(const Array& another)
+    bool operator==(const Array& another) const
     {
       bool result = *this == (T*)another;
       return result;
     }
-    bool operator==(const Array&& another)
+    bool operator==(const Array&& another) const
     {
       bool result = *this == (T*)another;
       return result;
@@ -456,7 +880,7 @@ namespace espmath{
      * @return true Not all values of the _array are contained in input.
      * @return false Every value of the _array is contained in input.
      */
-    bool operator!=(const T* input)
+    bool operator!=(const T* input) const
     {
       return !(*this == input);
     }
@@ -469,7 +893,7 @@ namespace espmath{
      */
     void operator+=(const T value)
     {
-      addConstToArray(_array, _array, _shape.columns, value);
+      addConstToArray(_array, _array, _shape.size, value);
     }
 
     /**
@@ -491,7 +915,7 @@ namespace espmath{
      */
     void operator*=(const T value)
     { 
-      mulConstByArray(_array, _array, _shape.columns, value);
+      mulConstByArray(_array, _array, _shape.size, value);
     }
 
     /**
@@ -502,7 +926,7 @@ namespace espmath{
      */
     void operator/=(const T value)
     {
-      divArrayByConst(_array, _array, _shape.columns, value);
+      divArrayByConst(_array, _array, _shape.size, value);
     }
 
     /**
@@ -513,7 +937,7 @@ namespace espmath{
      */
     void operator+=(const Array& another)
     { 
-      addArrayToArray((T*)another, _array, _array, _shape.columns);
+      addArrayToArray((T*)another, _array, _array, _shape.size);
     }
     void operator+=(const Array&& another)
     {
@@ -528,7 +952,7 @@ namespace espmath{
      */
     void operator-=(const Array& another)
     {
-      subArrayFromArray((T*)another, _array, _array, _shape.columns);
+      subArrayFromArray((T*)another, _array, _array, _shape.size);
     }
     void operator-=(const Array&& another)
     {
@@ -543,7 +967,7 @@ namespace espmath{
      */
     void operator*=(const Array& another)
     {
-      mulArrayByArray((T*)another, _array, _array, _shape.columns);
+      mulArrayByArray((T*)another, _array, _array, _shape.size);
     }
     void operator*=(const Array&& another)
     {
@@ -558,7 +982,7 @@ namespace espmath{
      */
     void operator/=(const Array& another)
     {
-      divArrayByArray(_array, another, _array, _shape.columns);
+      divArrayByArray(_array, another, _array, _shape.size);
     }
     void operator/=(const Array&& another)
     {
@@ -585,10 +1009,10 @@ namespace espmath{
      */
     Array& operator<<(const Array& another)
     {
-      for(size_t i = 0; i < another.shape.columns; i++)
-      {
-        *this = *this << another.flatten[i];
-      }
+      const size_t len = another.shape.columns;
+      reserve(_shape.columns + len);
+      for(size_t i = 0; i < len; i++)
+        this->append(another.flatten[i]);
       return *this;
     }
 
@@ -597,6 +1021,9 @@ namespace espmath{
     /**
      * @brief Append a value to the _array
      * 
+     * The capacity doubles whenever it runs out, so appending n values
+     * costs O(log n) allocations. Use reserve() when n is known.
+     * 
      * @param value 
      * @return true Successful appended
      * @return false Failed to append
@@ -604,32 +1031,72 @@ namespace espmath{
     bool append(const T value)
     {
       assert(_shape.rows == 1);
-      if(_shape.columns < _size/sizeof(T))
+      if (_shape.columns >= capacity() || !canBeDestroyed)
       {
-        _array[_shape.columns] = value;
-        _shape = shape2D(_shape.rows, _shape.columns+1);
-        return true;
+        const size_t minCapacity = ALIGNMENT/sizeof(T) > 0 ? ALIGNMENT/sizeof(T) : 1;
+        if (!reallocate(_shape.columns < minCapacity ? minCapacity : 2*_shape.columns))
+          return false;
       }
 
-      _size = _mem2alloc(_shape.columns+1);
+      _array[_shape.columns] = value;
+      _shape = shape2D(_shape.rows, _shape.columns+1);
+      return true;
+    }
 
-      if (_array)
-      {
-        heap_caps_free(_array);
-        _array = _size > 0 ? (T*)heap_caps_aligned_alloc(ALIGNMENT, _size, _caps) : NULL;
-      }
-      else
-      {
-        _array = _size > 0 ? (T*)heap_caps_aligned_alloc(ALIGNMENT, _size, _caps) : NULL;
-      }
+    /**
+     * @brief Make room for at least n elements, keeping the current ones
+     * 
+     * @param n Number of elements
+     * @return true Success
+     * @return false Allocation failure. The array is left untouched.
+     */
+    bool reserve(const size_t n)
+    {
+      if (n <= capacity() && canBeDestroyed)
+        return true;
+      return reallocate(n > _shape.size ? n : _shape.size);
+    }
 
-      if (_array)
-      {
-        _array[_shape.columns] = value;
-        _shape = shape2D(_shape.rows, _shape.columns+1);
+    /**
+     * @brief Set the number of elements of a one row array, keeping the first ones
+     * 
+     * Shrinking never allocates, growing allocates only beyond the capacity.
+     * The new elements are not initialized.
+     * 
+     * @param n Number of elements
+     * @return true Success
+     * @return false Allocation failure. The array is left untouched.
+     */
+    bool resize(const size_t n)
+    {
+      assert(_shape.rows == 1);
+      if (!reserve(n))
+        return false;
+      _shape = shape2D(1, n);
+      return true;
+    }
+
+    /**
+     * @brief Release the capacity that is not in use
+     * 
+     * @return true Success
+     * @return false Allocation failure. The array is left untouched.
+     */
+    bool shrinkToFit()
+    {
+      if (capacity() == _shape.size && canBeDestroyed)
         return true;
-      }
-      return false;
+      return reallocate(_shape.size);
+    }
+
+    /**
+     * @brief Get the number of elements the array can hold without allocating
+     * 
+     * @return size_t 
+     */
+    size_t capacity() const
+    {
+      return _size/sizeof(T);
     }
 
     /**
@@ -645,6 +1112,67 @@ namespace espmath{
       return _array == NULL ? false : true;
     }
 
+    /**
+     * @brief Get a view of the whole array
+     *
+     * @return ArrayView<T>
+     */
+    ArrayView<T> view() const
+    {
+      return ArrayView<T>(_array, _shape.size, 1, fracBits);
+    }
+
+    /**
+     * @brief Get a view of a row of the matrix
+     *
+     * @param r Row index
+     * @return ArrayView<T>
+     */
+    ArrayView<T> row(const size_t r) const
+    {
+      assert(r < _shape.rows);
+      return ArrayView<T>(_array + r*_shape.columns, _shape.columns, 1, fracBits);
+    }
+
+    /**
+     * @brief Get a view of a column of the matrix, without copying it
+     *
+     * @param c Column index
+     * @return ArrayView<T>
+     */
+    ArrayView<T> column(const size_t c) const
+    {
+      assert(c < _shape.columns);
+      return ArrayView<T>(_array + c, _shape.rows, _shape.columns, fracBits);
+    }
+
+    /**
+     * @brief Get a view of evenly spaced elements of the array
+     *
+     * Example:
+     * array = {1, 2, 3, 4, 5, 6};
+     *
+     * array.slice(1, 3, 2) -> {2, 4, 6}.
+     *
+     * @param start Index of the first element.
+     * @param length Number of elements.
+     * @param step Take one element out of step, e.g. 2 decimates by two.
+     * @return ArrayView<T>
+     */
+    ArrayView<T> slice(const size_t start, const size_t length, const size_t step = 1) const
+    {
+      return view().slice(start, length, step);
+    }
+
+    /**
+     * @brief Get the number of buffers allocated by Array<T> so far.
+     * 
+     * Meant for tests and profiling. It is not thread safe.
+     * 
+     * @return size_t 
+     */
+    static size_t allocations(){return allocationCounter();}
+
     /**
      * @brief Get the memory capabilities
      * 
@@ -673,7 +1201,9 @@ namespace espmath{
      * @param kernel 
      * @return Array output array with convolution result length of (siglen + Kernel -1)
      * 
-     * @note Float arrays make use of DSP instructions.
+     * @note Float and int16_t arrays make use of DSP instructions. int16_t
+     * products are accumulated on 40 bits, shifted right by the frac of the
+     * kernel and saturated, so the result keeps the frac of the array.
      */
     Array conv(const Array& kernel)
     {
@@ -687,14 +1217,21 @@ namespace espmath{
      */
     void copy(const Array& another)
     {
-      if (_array)
+      if (this == &another)
+        return;
+
+      if (canBeDestroyed && _array)
         heap_caps_free(_array);
 
       _shape = another.shape;
       _size = another.memSize();
-      _array = _size > 0 ? (T*)heap_caps_aligned_alloc(ALIGNMENT, _size, _caps) : NULL;
-      
-      for(size_t i = 0; i < _shape.columns; i++)
+      _array = allocate(_size);
+      fracBits = another.frac;
+      canBeDestroyed = true;
+      if (!_array)
+        _size = 0;
+
+      for(size_t i = 0; _array && i < _shape.size; i++)
         _array[i] = another.flatten[i];
     }
 
@@ -705,7 +1242,7 @@ namespace espmath{
      */
     void copyRef(Array& another)
     {
-      if (_array)
+      if (canBeDestroyed && _array)
         heap_caps_free(_array);
 
       _shape = another.shape;
@@ -717,15 +1254,173 @@ namespace espmath{
      * @brief Get the correlation array with the given pattern
      * 
      * @param pattern 
-     * @return Array<float>
+     * @return Array
      * 
-     * @note Float arrays make use of DSP instructions.
+     * @note Float and int16_t arrays make use of DSP instructions. The int16_t
+     * result has (siglen - patlen + 1) elements; its products are accumulated
+     * on 40 bits, shifted right by the frac of the pattern and saturated, so
+     * the result keeps the frac of the array.
      */
-    Array<float> correlation(const Array& pattern)
+    Array correlation(const Array& pattern)
     {
       return *this;
     }
 
+    /**
+     * @brief Get the matrix product of the array by another
+     *
+     * The columns of the array must match the rows of another (see shape2D::canX).
+     * The result takes the shape (rows x another.columns) and the fractional
+     * bits of the array.
+     *
+     * @param another
+     * @return Array
+     *
+     * @note Float and int16_t arrays make use of DSP instructions. int16_t
+     * products are accumulated on 32 bits and shifted right by frac at the end.
+     */
+    Array matmul(const Array& another) const
+    {
+      ESP_ERROR_CHECK(!_shape.canX(another.shape)); //"columns must match the rows of another!"
+      Array<T> product(fracBits, _shape*another.shape);
+      const size_t n = _shape.columns;
+      const size_t k = another.shape.columns;
+      for (size_t i = 0; product.flatten && i < _shape.rows; i++)
+        for (size_t j = 0; j < k; j++)
+        {
+          T acc = 0;
+          for (size_t p = 0; p < n; p++)
+            acc += _array[i*n + p]*another.flatten[p*k + j];
+          product.flatten[i*k + j] = acc;
+        }
+      return product;
+    }
+
+    /**
+     * @brief Get the minimum, maximum, their indices, sum, sum of squares,
+     * mean, variance and norm of the array in a single pass over the elements.
+     *
+     * Prefer it to several of the single statistics below, each one of them
+     * is a pass over the array.
+     *
+     * @return ArrayStats<T>
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     * Integer sums are accumulated on 64 bits, float sums on double.
+     */
+    ArrayStats<T> stats() const
+    {
+      ArrayStats<T> s;
+      reduce(s, true, true);
+      if (!_shape.size)
+        return s;
+      const double mean = (double)s.sum/_shape.size;
+      const double var = (double)s.sumsq/_shape.size - mean*mean;
+      s.mean = mean;
+      s.var = var > 0 ? var : 0;
+      s.norm2 = sqrt((double)s.sumsq);
+      return s;
+    }
+
+    /**
+     * @brief Get the smallest element. NaN elements are ignored.
+     *
+     * @return T The largest T value (+INFINITY for float) if the array is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    T min() const
+    {
+      ArrayStats<T> s;
+      reduce(s, false);
+      return s.min;
+    }
+
+    /**
+     * @brief Get the largest element. NaN elements are ignored.
+     *
+     * @return T The lowest T value (-INFINITY for float) if the array is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    T max() const
+    {
+      ArrayStats<T> s;
+      reduce(s, false);
+      return s.max;
+    }
+
+    /**
+     * @brief Get the index of the first smallest element
+     *
+     * @return size_t The size of the array if it is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    size_t argmin() const
+    {
+      ArrayStats<T> s;
+      reduce(s, false, true);
+      return s.argmin;
+    }
+
+    /**
+     * @brief Get the index of the first largest element
+     *
+     * @return size_t The size of the array if it is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    size_t argmax() const
+    {
+      ArrayStats<T> s;
+      reduce(s, false, true);
+      return s.argmax;
+    }
+
+    /**
+     * @brief Get the sum of the elements
+     *
+     * @return int64_t for integer arrays, double for float arrays.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    typename ArrayStats<T>::total_t sum() const
+    {
+      ArrayStats<T> s;
+      reduce(s, false);
+      return s.sum;
+    }
+
+    /**
+     * @brief Get the mean of the elements
+     *
+     * @return float 0 if the array is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    float mean() const
+    {
+      return _shape.size ? (double)sum()/_shape.size : 0;
+    }
+
+    /**
+     * @brief Get the population variance of the elements
+     *
+     * @return float 0 if the array is empty.
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    float var() const
+    {
+      return stats().var;
+    }
+
+    /**
+     * @brief Get the Euclidean norm of the array, sqrt of the sum of squares
+     *
+     * @return float
+     * @note float, int32_t, int16_t and int8_t arrays make use of DSP instructions.
+     */
+    float norm2() const
+    {
+      ArrayStats<T> s;
+      reduce(s, true);
+      return sqrt((double)s.sumsq);
+    }
+
     /**
      * @brief Compares to another array
      * 
@@ -760,11 +1455,11 @@ namespace espmath{
      * @brief 
      * 
      * @param newFrac New Fractional bits value.
-     * @note It only accepts new values for int16_t arrays.
+     * @note It only accepts new values for int16_t and int32_t (e.g. Q16.16) arrays.
      */
     void updateFractional(uint8_t newFrac)
     {
-      if (sizeof(T) == 2) return; // It makes sure that T is 2 bytes long.
+      if (!std::is_same<T, int16_t>::value && !std::is_same<T, int32_t>::value) return;
       fracBits = newFrac;
     }
 
@@ -792,6 +1487,109 @@ namespace espmath{
       return blocks*sizeof(T);
     }
 
+    /**
+     * @brief Allocate an aligned buffer with the array capabilities
+     * 
+     * @param bytes 
+     * @return T* NULL if bytes is 0 or the allocation failed
+     */
+    T* allocate(const size_t bytes)
+    {
+      if (!bytes)
+        return NULL;
+      allocationCounter()++;
+      return (T*)heap_caps_aligned_alloc(ALIGNMENT, bytes, _caps);
+    }
+
+    /**
+     * @brief Move the elements to a new buffer of n elements
+     * 
+     * @param n Number of elements. It must not be smaller than the array.
+     * @return true Success
+     * @return false Allocation failure. The array is left untouched.
+     */
+    bool reallocate(const size_t n)
+    {
+      const size_t newSize = _mem2alloc(n);
+      T* newArray = allocate(newSize);
+      if (!newArray && newSize > 0)
+        return false;
+
+      const size_t len = _shape.size < capacity() ? _shape.size : capacity();
+      if (len > 0)
+        memcpy(newArray, _array, len*sizeof(T));
+
+      if (canBeDestroyed && _array)
+        heap_caps_free(_array);
+      _array = newArray;
+      _size = newSize;
+      canBeDestroyed = true;
+      return true;
+    }
+
+    /**
+     * @brief Leave the array empty without freeing its buffer
+     * 
+     */
+    void release()
+    {
+      _array = NULL;
+      _size = 0;
+      _shape = shape2D(1,0);
+      fracBits = 0;
+      canBeDestroyed = true;
+    }
+
+    /**
+     * @brief a op b
+     * 
+     * @return bool
+     */
+    static bool compareValues(const T a, const T b, const Comparison op)
+    {
+      switch (op)
+      {
+        case CMP_EQ: return equal(a, b);
+        case CMP_NE: return !equal(a, b);
+        case CMP_LT: return a < b;
+        case CMP_GE: return a >= b;
+        case CMP_GT: return a > b;
+        case CMP_LE: return a <= b;
+      }
+      return false;
+    }
+
+    static bool equal(const T a, const T b){return a == b;}
+
+    /**
+     * @brief Minimum, maximum, sum and, if squares is set, sum of squares of the elements
+     *
+     * @param s Filled statistics
+     * @param squares Accumulate the sum of squares
+     * @param indices Find the indices of the first minimum and maximum, the
+     * size of the array if there is none
+     */
+    void reduce(ArrayStats<T>& s, const bool squares, const bool indices = false) const
+    {
+      s.min = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+      s.max = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+      s.argmin = s.argmax = _shape.size;
+      for (size_t i = 0; i < _shape.size; i++)
+      {
+        const T value = _array[i];
+        if (value < s.min || (s.argmin == _shape.size && value == s.min)) {s.min = value; s.argmin = i;}
+        if (s.max < value || (s.argmax == _shape.size && value == s.max)) {s.max = value; s.argmax = i;}
+        s.sum += value;
+        if (squares) s.sumsq += (typename ArrayStats<T>::total_t)value*value;
+      }
+    }
+
+    static size_t& allocationCounter()
+    {
+      static size_t counter = 0;
+      return counter;
+    }
+
     /**
      * @brief Return the allocated memory capabilities.
      * 
@@ -814,6 +1612,33 @@ namespace espmath{
     }
   };
 
+  /**
+   * @brief Select element-wise between two arrays
+   * 
+   * Example:
+   * mask = {1, 0, 1};
+   * a    = {1, 2, 3};
+   * b    = {4, 5, 6};
+   * 
+   * where(mask, a, b) -> {1, 5, 3}.
+   * 
+   * @tparam T Array type
+   * @param mask Mask of the shape of the arrays
+   * @param a Elements taken where the mask is true
+   * @param b Elements taken where the mask is false
+   * @return Array<T> with the shape and the fractional bits of a.
+   * @note float, int32_t and int16_t arrays make use of DSP instructions.
+   */
+  template<typename T>
+  Array<T> where(const ArrayMask& mask, const Array<T>& a, const Array<T>& b)
+  {
+    assert(a.shape == mask.shape() && b.shape == mask.shape());
+    Array<T> selected(a.frac, a.shape);
+    for (size_t i = 0; selected.flatten && i < a.shape.size; i++)
+      selected.flatten[i] = mask[i] ? a.flatten[i] : b.flatten[i];
+    return selected;
+  }
+
   template<>
   inline uint32_t Array<int32_t>::memCaps(){return MALLOC_CAP_32BIT;}
   template<>
@@ -837,11 +1662,14 @@ namespace espmath{
   // template<>
   // inline Array<float>::operator float*() const {return _array;}
 
+  template<>
+  inline bool Array<float>::equal(const float a, const float b){return eqFloats(a, b);}
+
   template<>
   inline bool Array<float>::diff(const Array<float>& another, const float EPSILON)
   {
     size_t i = 0;
-    while(i < _shape.columns)
+    while(i < _shape.size)
     {
       if (!eqFloats(_array[i], another.flatten[i], EPSILON))
         return true;
@@ -850,254 +1678,292 @@ namespace espmath{
     return false;
   }
 
-#ifdef CONFIG_IDF_TARGET_ESP32S3
-#if CONFIG_IDF_TARGET_ESP32S3
+#if ESP_MATH_DSP
 
   template<>
   inline void Array<float>::operator+=(const float value)
   {
-    exec_dsp(dsps_addc_f32_esp, _array, _array, _shape.columns, value);
+    kernels::addc(_array, value, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator+=(const int32_t value)
   {
-    exec_dsp(dsps_addc_s32_esp, _array, _array, _shape.columns, value);
+    kernels::addc(_array, value, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator+=(const uint32_t value)
   {
-    exec_dsp(dsps_addc_s32_esp, (int32_t*)_array, (int32_t*)_array, _shape.columns, value);
+    kernels::addc(_array, value, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator+=(const int16_t value)
   {
-    exec_dsp(dsps_addc_s16_esp, _array, _array, _shape.columns, &value, 1, 1, 0);
+    kernels::addc(_array, value, _array, _shape.size, Array<int16_t>::frac);
   }
 
   template<>
   inline void Array<int8_t>::operator+=(const int8_t value)
   {
-    exec_dsp(dsps_addc_s8_esp, _array, _array, _shape.columns, &value);
+    kernels::addc(_array, value, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator-=(const float value)
   {
-    exec_dsp(dsps_subc_f32_esp, _array, _array, _shape.columns, value);
+    kernels::subc(_array, value, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator-=(const int32_t value)
   {
-    exec_dsp(dsps_subc_s32_esp, _array, _array, _shape.columns, value);
+    kernels::subc(_array, value, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator-=(const uint32_t value)
   {
-    exec_dsp(dsps_subc_s32_esp, (int32_t*)_array, (int32_t*)_array, _shape.columns, value);
+    kernels::subc(_array, value, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator-=(const int16_t value)
   {
-    exec_dsp(dsps_subc_s16_esp, _array, _array, _shape.columns, &value, 1, 1, 0);
+    kernels::subc(_array, value, _array, _shape.size, Array<int16_t>::frac);
   }
 
   template<>
   inline void Array<int8_t>::operator-=(const int8_t value)
   {
-    exec_dsp(dsps_subc_s8_esp, _array, _array, _shape.columns, &value);
+    kernels::subc(_array, value, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator*=(const float value)
   {
-    exec_dsp(dsps_mulc_f32_esp, _array, _array, _shape.columns, value);
+    kernels::mulc(_array, value, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator*=(const int32_t value)
   {
-    exec_dsp(dsps_mulc_s32_esp, _array, _array, _shape.columns, value);
+    kernels::mulc(_array, value, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator*=(const uint32_t value)
   {
-    exec_dsp(dsps_mulc_s32_esp, (int32_t*)_array, (int32_t*)_array, _shape.columns, (int32_t)value);
+    kernels::mulc(_array, value, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int8_t>::operator*=(const int8_t value)
   {
-    exec_dsp(dsps_mulc_s8_esp, _array, _array, _shape.columns, &value);
+    kernels::mulc(_array, value, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator*=(const int16_t value)
   {
-    exec_dsp(dsps_mulc_s16_esp, _array, _array, _shape.columns, value, 1, 1, Array<int16_t>::frac);
+    kernels::mulc(_array, value, _array, _shape.size, Array<int16_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator/=(const float value)
   {
-    exec_dsp(dsps_divc_f32_esp, _array, _array, _shape.columns, value);
+    kernels::divc(_array, value, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator/=(const int32_t value)
   {
-    exec_dsp(dsps_divc_s32_esp, _array, _array, _shape.columns, value);
+    kernels::divc(_array, value, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator/=(const uint32_t value)
   {
-    exec_dsp(dsps_divc_s32_esp, (int32_t*)_array, (int32_t*)_array, _shape.columns, (int32_t)value);
+    kernels::divc((const int32_t*)_array, (int32_t)value, (int32_t*)_array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator/=(const int16_t value)
   {
-    exec_dsp(dsps_divc_s16_esp, _array, _array, _shape.columns, value, 1, 1, Array<int16_t>::frac);
+    kernels::divc(_array, value, _array, _shape.size, Array<int16_t>::frac);
   }
 
   template<>
   inline void Array<int8_t>::operator/=(const int8_t value)
   {
-    exec_dsp(dsps_divc_s8_esp, _array, _array, _shape.columns, value);
+    kernels::divc(_array, value, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator+=(const Array<float>& another)
   {
-    exec_dsp(dsps_add_f32_esp, _array, another, _array, _shape.columns);
+    kernels::add(_array, another.flatten, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator+=(const Array<int32_t>& another)
   {
-    exec_dsp(dsps_add_s32_esp, _array, another, _array, _shape.columns);
+    kernels::add(_array, another.flatten, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator+=(const Array<uint32_t>& another)
   {
-    exec_dsp(dsps_add_s32_esp, (int32_t*)_array, (int32_t*)another.flatten, (int32_t*)_array, _shape.columns);
+    kernels::add(_array, another.flatten, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator+=(const Array<int16_t>& another)
   {
-    exec_dsp(dsps_add_s16_esp, _array, another, _array, _shape.columns, 1, 1, 1, 0);
+    kernels::add(_array, another.flatten, _array, _shape.size, FixedFormats{Array<int16_t>::frac, another.frac, Array<int16_t>::frac});
   }
 
   template<>
   inline void Array<int8_t>::operator+=(const Array<int8_t>& another)
   {
-    exec_dsp(dsps_add_s8_esp, _array, another, _array, _shape.columns);
+    kernels::add(_array, another.flatten, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator-=(const Array<float>& another)
   {
-    exec_dsp(dsps_sub_f32_esp, _array, another, _array, _shape.columns);
+    kernels::sub(_array, another.flatten, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator-=(const Array<int32_t>& another)
   {
-    exec_dsp(dsps_sub_s32_esp, _array, another, _array, _shape.columns);
+    kernels::sub(_array, another.flatten, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator-=(const Array<uint32_t>& another)
   {
-    exec_dsp(dsps_sub_s32_esp, (int32_t*)_array, (int32_t*)another.flatten, (int32_t*)_array, _shape.columns);
+    kernels::sub(_array, another.flatten, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator-=(const Array<int16_t>& another)
   {
-    exec_dsp(dsps_sub_s16_esp, _array, another, _array, _shape.columns, 1, 1, 1, 0);
+    kernels::sub(_array, another.flatten, _array, _shape.size, FixedFormats{Array<int16_t>::frac, another.frac, Array<int16_t>::frac});
   }
 
   template<>
   inline void Array<int8_t>::operator-=(const Array<int8_t>& another)
   {
-    exec_dsp(dsps_sub_s8_esp, _array, another, _array, _shape.columns);
+    kernels::sub(_array, another.flatten, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator*=(const Array<float>& another)
   {
-    exec_dsp(dsps_mul_f32_esp, _array, another, _array, _shape.columns);
+    kernels::mul(_array, another.flatten, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator*=(const Array<int32_t>& another)
   {
-    exec_dsp(dsps_mul_s32_esp, _array, another, _array, _shape.columns);
+    kernels::mul(_array, another.flatten, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<uint32_t>::operator*=(const Array<uint32_t>& another)
   {
-    exec_dsp(dsps_mul_s32_esp, (int32_t*)_array, (int32_t*)another.flatten, (int32_t*)_array, _shape.columns);
+    kernels::mul(_array, another.flatten, _array, _shape.size, Array<uint32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator*=(const Array<int16_t>& another)
   {
-    exec_dsp(dsps_mul_s16_esp,_array, another, _array, _shape.columns, 1, 1, 1, Array<int16_t>::frac);
+    kernels::mul(_array, another.flatten, _array, _shape.size, FixedFormats{Array<int16_t>::frac, another.frac, Array<int16_t>::frac});
   }
 
   template<>
   inline void Array<int8_t>::operator*=(const Array<int8_t>& another)
   {
-    exec_dsp(dsps_mul_s8_esp,_array, another, _array, _shape.columns);
+    kernels::mul(_array, another.flatten, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
   inline void Array<float>::operator/=(const Array<float>& another)
   {
-    exec_dsp(dsps_div_f32_esp, _array, another, _array, _shape.columns);
+    kernels::div(_array, another.flatten, _array, _shape.size, Array<float>::frac);
   }
 
   template<>
   inline void Array<int32_t>::operator/=(const Array<int32_t>& another)
   {
-    exec_dsp(dsps_div_s32_esp, _array, another, _array, _shape.columns);
+    kernels::div(_array, another.flatten, _array, _shape.size, Array<int32_t>::frac);
   }
 
   template<>
   inline void Array<int16_t>::operator/=(const Array<int16_t>& another)
   {
-    exec_dsp(dsps_div_s16_esp, _array, another, _array, _shape.columns, 1, 1, 1, Array<int16_t>::frac);
+    kernels::div(_array, another.flatten, _array, _shape.size, FixedFormats{Array<int16_t>::frac, another.frac, Array<int16_t>::frac});
   }
 
   template<>
   inline void Array<int8_t>::operator/=(const Array<int8_t>& another)
   {
-    exec_dsp(dsps_div_s8_esp, _array, another, _array, _shape.columns);
+    kernels::div(_array, another.flatten, _array, _shape.size, Array<int8_t>::frac);
   }
 
   template<>
-  inline Array<float> Array<float>::operator==(const float value)
-  {
-    Array<float> newArray(_shape);
-    for (size_t i = 0; i < _shape.size; i++)
-      newArray.flatten[i] = (float)eqFloats(_array[i], value);
-    return newArray;
-  }
+  ArrayMask Array<float>::compare(const float value, const Comparison op) const;
+
+  template<>
+  ArrayMask Array<int32_t>::compare(const int32_t value, const Comparison op) const;
+
+  template<>
+  ArrayMask Array<int16_t>::compare(const int16_t value, const Comparison op) const;
+
+  template<>
+  ArrayMask Array<int8_t>::compare(const int8_t value, const Comparison op) const;
+
+  template<>
+  void Array<float>::reduce(ArrayStats<float>& s, const bool squares, const bool indices) const;
+
+  template<>
+  void Array<int32_t>::reduce(ArrayStats<int32_t>& s, const bool squares, const bool indices) const;
+
+  template<>
+  void Array<int16_t>::reduce(ArrayStats<int16_t>& s, const bool squares, const bool indices) const;
+
+  template<>
+  void Array<int8_t>::reduce(ArrayStats<int8_t>& s, const bool squares, const bool indices) const;
+
+  template<>
+  Array<float> Array<float>::operator[](const ArrayMask& mask) const;
 
   template<>
-  inline bool Array<float>::operator==(const float* input)
+  Array<int32_t> Array<int32_t>::operator[](const ArrayMask& mask) const;
+
+  template<>
+  Array<uint32_t> Array<uint32_t>::operator[](const ArrayMask& mask) const;
+
+  template<>
+  Array<int16_t> Array<int16_t>::operator[](const ArrayMask& mask) const;
+
+  template<>
+  Array<float> where(const ArrayMask& mask, const Array<float>& a, const Array<float>& b);
+
+  template<>
+  Array<int32_t> where(const ArrayMask& mask, const Array<int32_t>& a, const Array<int32_t>& b);
+
+  template<>
+  Array<uint32_t> where(const ArrayMask& mask, const Array<uint32_t>& a, const Array<uint32_t>& b);
+
+  template<>
+  Array<int16_t> where(const ArrayMask& mask, const Array<int16_t>& a, const Array<int16_t>& b);
+
+  template<>
+  inline bool Array<float>::operator==(const float* input) const
   {
     size_t i = 0;
     while( i < _shape.size)
@@ -1110,74 +1976,40 @@ namespace espmath{
   }
 
   template<>
-  inline Array<float> Array<float>::conv(const Array<float>& kernel);
-
-  template<>
-  inline Array<float> Array<float>::correlation(const Array<float>& pattern);
-
-  Array<float> operator+(const Array<float>& onearray, const Array<float> another);
-  Array<int32_t> operator+(const Array<int32_t>& onearray, const Array<int32_t> another);
-  Array<uint32_t> operator+(const Array<uint32_t>& onearray, const Array<uint32_t> another);
-  Array<int16_t> operator+(const Array<int16_t>& onearray, const Array<int16_t> another);
-  Array<int8_t> operator+(const Array<int8_t>& onearray, const Array<int8_t> another);
-  Array<float> operator+(const Array<float>& onearray, const float value);
-  Array<int32_t> operator+(const Array<int32_t>& onearray, const int32_t value);
-  Array<uint32_t> operator+(const Array<uint32_t>& onearray, const uint32_t value);
-  Array<int16_t> operator+(const Array<int16_t>& onearray, const int16_t value);
-  Array<int8_t> operator+(const Array<int8_t>& onearray, const int8_t value);
-  Array<float> operator+(const float value, const Array<float> onearray);
-  Array<int32_t> operator+(const int32_t value, const Array<int32_t> onearray);
-  Array<uint32_t> operator+(const uint32_t value, const Array<uint32_t> onearray);
-  Array<int16_t> operator+(const int16_t value, const Array<int16_t> onearray);
-  Array<int8_t> operator+(const int8_t value, const Array<int8_t> onearray);
-  Array<float> operator-(const Array<float>& onearray, const Array<float> another);
-  Array<int32_t> operator-(const Array<int32_t>& onearray, const Array<int32_t> another);
-  Array<uint32_t> operator-(const Array<uint32_t>& onearray, const Array<uint32_t> another);
-  Array<int16_t> operator-(const Array<int16_t>& onearray, const Array<int16_t> another);
-  Array<int8_t> operator-(const Array<int8_t>& onearray, const Array<int8_t> another);
-  Array<float> operator-(const Array<float>& onearray, const float value);
-  Array<int32_t> operator-(const Array<int32_t>& onearray, const int32_t value);
-  Array<uint32_t> operator-(const Array<uint32_t>& onearray, const uint32_t value);
-  Array<int16_t> operator-(const Array<int16_t>& onearray, const int16_t value);
-  Array<int8_t> operator-(const Array<int8_t>& onearray, const int8_t value);
-  Array<float> operator-(const float value, const Array<float> onearray);
-  Array<int32_t> operator-(const int32_t value, const Array<int32_t> onearray);
-  Array<uint32_t> operator-(const uint32_t value, const Array<uint32_t> onearray);
-  Array<int16_t> operator-(const int16_t value, const Array<int16_t> onearray);
-  Array<int8_t> operator-(const int8_t value, const Array<int8_t> onearray);
-  Array<float> operator*(const Array<float>& onearray, const Array<float> another);
-  Array<int32_t> operator*(const Array<int32_t>& onearray, const Array<int32_t> another);
-  Array<uint32_t> operator*(const Array<uint32_t>& onearray, const Array<uint32_t> another);
-  Array<int16_t> operator*(const Array<int16_t>& onearray, const Array<int16_t> another);
-  Array<int8_t> operator*(const Array<int8_t>& onearray, const Array<int8_t> another);
-  Array<float> operator*(const Array<float>& onearray, const float value);
-  Array<int32_t> operator*(const Array<int32_t>& onearray, const int32_t value);
-  Array<uint32_t> operator*(const Array<uint32_t>& onearray, const uint32_t value);
-  Array<int16_t> operator*(const Array<int16_t>& onearray, const int16_t value);
-  Array<int8_t> operator*(const Array<int8_t>& onearray, const int8_t value);
-  Array<float> operator*(const float value, const Array<float> onearray);
-  Array<int32_t> operator*(const int32_t value, const Array<int32_t> onearray);
-  Array<uint32_t> operator*(const uint32_t value, const Array<uint32_t> onearray);
-  Array<int16_t> operator*(const int16_t value, const Array<int16_t> onearray);
-  Array<int8_t> operator*(const int8_t value, const Array<int8_t> onearray);
-  Array<float> operator/(const Array<float>& onearray, const float value);
-  Array<int32_t> operator/(const Array<int32_t>& onearray, const int32_t value);
-  Array<int16_t> operator/(const Array<int16_t>& onearray, const int16_t value);
-  Array<int8_t> operator/(const Array<int8_t>& onearray, const int8_t value);
-  Array<float> operator/(const float value, const Array<float> another);
-  Array<int32_t> operator/(const int32_t value, const Array<int32_t> onearray);
-  Array<int16_t> operator/(const int16_t value, const Array<int16_t> onearray);
-  Array<int8_t> operator/(const int8_t value, const Array<int8_t> onearray);
-  Array<float> operator/(const Array<float>& onearray, const Array<float> another);
-  Array<int32_t> operator/(const Array<int32_t>& onearray, const Array<int32_t> another);
-  Array<int16_t> operator/(const Array<int16_t>& onearray, const Array<int16_t> another);
-  Array<int8_t> operator/(const Array<int8_t>& onearray, const Array<int8_t> another);
+  Array<float> Array<float>::conv(const Array<float>& kernel);
+
+  template<>
+  Array<float> Array<float>::correlation(const Array<float>& pattern);
+
+  template<>
+  Array<int16_t> Array<int16_t>::conv(const Array<int16_t>& kernel);
+
+  template<>
+  Array<int16_t> Array<int16_t>::correlation(const Array<int16_t>& pattern);
+
+  template<>
+  Array<float> Array<float>::matmul(const Array<float>& another) const;
+
+  template<>
+  Array<int16_t> Array<int16_t>::matmul(const Array<int16_t>& another) const;
+
   float operator^(const Array<float>& onearray, const Array<float> another);
-  int16_t operator^(const Array<int16_t>& onearray, const Array<int16_t> another);
+  /**
+   * @brief Dot product of fixed point arrays
+   *
+   * The products are accumulated on a wide accumulator and shifted right by
+   * frac once, so the result is in the format of the arrays, on 32 bits.
+   */
+  int32_t operator^(const Array<int16_t>& onearray, const Array<int16_t> another);
+  /**
+   * @brief Dot product of int32_t arrays, accumulated on 64 bits and saturated to 32 bits
+   */
   int32_t operator^(const Array<int32_t>& onearray, const Array<int32_t> another);
-  int8_t operator^(const Array<int8_t>& onearray, const Array<int8_t> another);
+  /**
+   * @brief Dot product of int8_t arrays, accumulated and returned on 32 bits
+   */
+  int32_t operator^(const Array<int8_t>& onearray, const Array<int8_t> another);
 
-#endif
 #endif
 }
 
@@ -0,0 +1,143 @@
+#ifndef _ESP_MATH_BENCHMARK_H_
+#define _ESP_MATH_BENCHMARK_H_
+
+#include "esp_platform.h"
+#include "esp_opt.h"
+
+#include <stdio.h>
+#include <algorithm>
+
+namespace espmath{
+
+  /**
+   * @brief Name of an element type as written in benchmark reports
+   *
+   * @tparam T Element type
+   * @return const char*
+   */
+  template<typename T> inline const char* typeName(){return "unknown";}
+  template<> inline const char* typeName<float>(){return "float";}
+  template<> inline const char* typeName<int32_t>(){return "int32";}
+  template<> inline const char* typeName<uint32_t>(){return "uint32";}
+  template<> inline const char* typeName<int16_t>(){return "int16";}
+  template<> inline const char* typeName<int8_t>(){return "int8";}
+
+  /**
+   * @brief Benchmark harness
+   *
+   * Every case is warmed up once and then measured `samples` times with
+   * interrupts masked (unless a case asks otherwise), using dsp_get_ccount(). The cost of reading the counter
+   * is measured once and subtracted from every sample.
+   *
+   * The report is a single JSON document written to the given stream
+   * (stdout goes through the UART on ESP32 devices):
+   *
+   *   {"target": "esp32s3", "samples": 101, "overhead": 2, "results": [
+   *     {"op": "add", "type": "int16", "length": 256, "aligned": true,
+   *      "min": 120, "median": 124, "p99": 180, "bytes_per_cycle": 12.387},
+   *     ...
+   *   ]}
+   *
+   * The document is closed when the benchmark is destroyed.
+   */
+  class Benchmark
+  {
+  public:
+    /**
+     * @brief Construct a new Benchmark object and open the report
+     *
+     * @param output Stream the JSON report is written to.
+     * @param samples Number of measurements per case.
+     */
+    Benchmark(FILE* output = stdout, const size_t samples = 101):_output(output),_samples(samples > 0 ? samples : 1)
+    {
+      _cycles = (uint32_t*)malloc(_samples*sizeof(uint32_t));
+      ESP_ERROR_CHECK(_cycles == NULL);
+      _overhead = 0;
+      _overhead = measure([]{});
+      fprintf(_output, "{\"target\": \"%s\", \"samples\": %u, \"overhead\": %u, \"results\": [",\
+              ESP_MATH_HOST ? "host" : "esp32s3", (unsigned)_samples, (unsigned)_overhead);
+    }
+
+    /**
+     * @brief Destroy the Benchmark object and close the report
+     *
+     */
+    ~Benchmark()
+    {
+      fprintf(_output, "\n]}\n");
+      fflush(_output);
+      free(_cycles);
+    }
+
+    /**
+     * @brief Measure a case and append it to the report
+     *
+     * A case is aligned when its length fills whole 16 bytes vectors, i.e.
+     * the kernels do not go through their tail loop.
+     *
+     * @tparam T Element type
+     * @tparam Func Callable with no arguments
+     * @param op Operation name
+     * @param length Number of elements processed
+     * @param bytes Bytes read and written by one call
+     * @param func Case to measure
+     * @param masked Measure with interrupts masked. Cases that block (e.g.
+     * waiting for the other core) must be measured unmasked.
+     */
+    template<typename T, typename Func>
+    void run(const char* op, const size_t length, const size_t bytes, Func func, const bool masked = true)
+    {
+      const uint32_t median = measure(func, masked);
+      fprintf(_output, "%s\n  {\"op\": \"%s\", \"type\": \"%s\", \"length\": %u, \"aligned\": %s,"\
+              " \"min\": %u, \"median\": %u, \"p99\": %u, \"bytes_per_cycle\": %.3f}",\
+              _cases++ ? "," : "", op, typeName<T>(), (unsigned)length, (length*sizeof(T)) % ALIGNMENT ? "false" : "true",\
+              (unsigned)_cycles[0], (unsigned)median, (unsigned)percentile(99),\
+              median ? (double)bytes/median : 0.0);
+    }
+
+  private:
+    FILE* _output;
+    size_t _samples;
+    size_t _cases = 0;
+    uint32_t* _cycles;
+    uint32_t _overhead;
+
+    /**
+     * @brief Fill _cycles with sorted samples of func
+     *
+     * @return uint32_t median
+     */
+    template<typename Func>
+    uint32_t measure(Func func, const bool masked = true)
+    {
+      func(); /* warm up the cache */
+      for (size_t i = 0; i < _samples; i++)
+      {
+        unsigned intlevel = masked ? dsp_ENTER_CRITICAL() : 0;
+        uint32_t start = dsp_get_ccount();
+        func();
+        uint32_t end = dsp_get_ccount();
+        if (masked)
+          dsp_EXIT_CRITICAL(intlevel);
+        _cycles[i] = end - start > _overhead ? end - start - _overhead : 0;
+      }
+      std::sort(_cycles, _cycles + _samples);
+      return percentile(50);
+    }
+
+    /**
+     * @brief Nearest-rank percentile of the last measurement
+     *
+     * @param p Percentile in [1, 100]
+     * @return uint32_t
+     */
+    uint32_t percentile(const unsigned p) const
+    {
+      size_t rank = (p*_samples + 99)/100;
+      return _cycles[rank > 0 ? rank - 1 : 0];
+    }
+  };
+}
+
+#endif
@@ -1,10 +1,10 @@
 #ifndef _ESP_DSP_H_
 #define _ESP_DSP_H_
 
-#include <sdkconfig.h>
+#include "esp_platform.h"
+#include "esp_parallel.h"
 
-#ifdef CONFIG_IDF_TARGET_ESP32S3
-#if CONFIG_IDF_TARGET_ESP32S3
+#if ESP_MATH_DSP
 #include "dsp/add/dsps_add_esp.h"
 #include "dsp/sub/dsps_sub_esp.h"
 #include "dsp/mul/dsps_mul_esp.h"
@@ -13,8 +13,17 @@
 #include "dsp/subc/dsps_subc_esp.h"
 #include "dsp/mulc/dsps_mulc_esp.h"
 #include "dsp/divc/dsps_divc_esp.h"
+#include "dsp/sum/dsps_vsum_esp.h"
 #include "dsp/dopP/dot_product.h"
-#endif
+#include "dsp/conv/dsps_conv_esp.h"
+#include "dsp/mmul/dsps_mmul_esp.h"
+#include "dsp/cmp/dsps_cmp_esp.h"
+#include "dsp/compress/dsps_compress_esp.h"
+#include "dsp/select/dsps_select_esp.h"
+#include "dsp/stats/dsps_stats_esp.h"
+#include "dsp/fir/dsps_fir_esp.h"
+#include "dsp/biquad/dsps_biquad_esp.h"
+#include "dsp/fft/dsps_fft_esp.h"
 #endif
 
 #define exec_dsp(dsp_func, ...)\
@@ -24,4 +33,162 @@ dsp_func(__VA_ARGS__);\
 portCLEAR_INTERRUPT_MASK_FROM_ISR(intlevel);\
 }\
 
-#endif
\ No newline at end of file
+/**
+ * @brief Default bound of the critical sections of element-wise kernels,
+ * in elements (0: no bound)
+ */
+#ifndef ESP_MATH_DSP_CHUNK
+#define ESP_MATH_DSP_CHUNK 4096
+#endif
+
+/**
+ * @brief Default bound of the critical sections of element-wise kernels,
+ * in CPU cycles (0: no bound). A target the chunks are sized to, see DspChunking
+ */
+#ifndef ESP_MATH_DSP_CHUNK_CYCLES
+#define ESP_MATH_DSP_CHUNK_CYCLES 0
+#endif
+
+namespace espmath{
+  /**
+   * @brief Bound of the critical sections of element-wise kernels, and what was measured
+   *
+   * exec_dsp masks interrupts for the whole kernel call. Element-wise kernels
+   * (the ones behind Array arithmetic), comparisons, masks and reductions
+   * (stats, dot products) are split instead into chunks, each one in its own critical section, so
+   * that interrupts are served in between.
+   *
+   * A chunk holds at most elements elements. The cycles bound is a target,
+   * not a guarantee: the chunk length is adapted after every chunk from the
+   * cycles the previous one took (growing at most twice longer), starting
+   * from a single granule. A chunk can still exceed it when the first
+   * granule alone takes longer, or when the cost per element rises between
+   * chunks (cache misses, the other core on the bus); longestCycles tells by
+   * how much. Chunks are multiples of 16 elements (at least
+   * 16), which keeps the 16 bytes alignment of the vector kernels; bitmask
+   * kernels (compare, compress, select) use 32, a whole mask word.
+   */
+  struct DspChunking
+  {
+    size_t elements;          /* elements per critical section, 0: no bound */
+    uint32_t cycles;          /* cycles per critical section, 0: no bound */
+    size_t longestElements;   /* longest critical section measured, in elements */
+    uint32_t longestCycles;   /* longest critical section measured, in cycles */
+    size_t sections;          /* critical sections entered */
+
+    void resetStats()
+    {
+      longestElements = 0;
+      longestCycles = 0;
+      sections = 0;
+    }
+
+    /**
+     * @brief Add what another run measured (e.g. on the other core)
+     */
+    void merge(const DspChunking& another)
+    {
+      longestElements = another.longestElements > longestElements ? another.longestElements : longestElements;
+      longestCycles = another.longestCycles > longestCycles ? another.longestCycles : longestCycles;
+      sections += another.sections;
+    }
+  };
+
+  /**
+   * @brief Chunking of the element-wise kernels, set with ESP_MATH_DSP_CHUNK
+   * and ESP_MATH_DSP_CHUNK_CYCLES and changeable at runtime
+   *
+   * @return DspChunking&
+   */
+  inline DspChunking& dspChunking()
+  {
+    static DspChunking chunking = {ESP_MATH_DSP_CHUNK, ESP_MATH_DSP_CHUNK_CYCLES, 0, 0, 0};
+    return chunking;
+  }
+
+  /**
+   * @brief Run kernel over the elements [begin..begin + len), one bounded critical section per chunk
+   *
+   * @param chunking Bounds, and where the measures go
+   * @param granule Chunks are a multiple of it
+   */
+  template<typename Kernel>
+  inline void execDspChunks(const size_t begin, const size_t len, Kernel& kernel, DspChunking& chunking, const size_t granule = 16)
+  {
+    size_t chunk = chunking.cycles ? granule : len;
+    if (chunking.elements && chunk > chunking.elements)
+      chunk = chunking.elements;
+    for (size_t i = 0; i < len;)
+    {
+      chunk = chunk < granule ? granule : chunk - chunk % granule;
+      const size_t n = len - i < chunk ? len - i : chunk;
+      unsigned intlevel = portSET_INTERRUPT_MASK_FROM_ISR();
+      const uint32_t start = dsp_get_ccount();
+      kernel(begin + i, n);
+      const uint32_t cycles = dsp_get_ccount() - start;
+      portCLEAR_INTERRUPT_MASK_FROM_ISR(intlevel);
+      chunking.sections++;
+      if (n > chunking.longestElements)
+        chunking.longestElements = n;
+      if (cycles > chunking.longestCycles)
+        chunking.longestCycles = cycles;
+      i += n;
+      if (chunking.cycles && cycles)
+      {
+        /* Next chunk sized after the cycles per element of this one, at most twice as long */
+        chunk = (size_t)((uint64_t)n*chunking.cycles/cycles);
+        if (chunk > 2*n)
+          chunk = 2*n;
+        if (chunking.elements && chunk > chunking.elements)
+          chunk = chunking.elements;
+      }
+    }
+  }
+
+  /**
+   * @brief Run a kernel over len elements, one bounded critical section per
+   * chunk, telling it which part of the split it runs
+   *
+   * Reductions keep one partial result per part, so that both cores never
+   * write the same one, and combine them afterwards.
+   *
+   * @param len Number of elements
+   * @param kernel kernel(i, n, part) processes the elements [i..i + n); part
+   * is 0 on the other core, 1 on the caller
+   * @param granule Chunks and parts are a multiple of it
+   */
+  template<typename Kernel>
+  inline void execDspChunkedParts(const size_t len, Kernel kernel, const size_t granule = 16)
+  {
+    DspChunking& chunking = dspChunking();
+    DspChunking other = chunking;
+    other.resetStats();
+    auto job = [&](const size_t begin, const size_t count, const int part)
+    {
+      auto chunk = [&](const size_t i, const size_t n){kernel(i, n, part);};
+      execDspChunks(begin, count, chunk, part ? chunking : other, granule);
+    };
+    if (parallelSplit(len, len, granule, job))
+      chunking.merge(other);
+    else
+      job(0, len, 1);
+  }
+
+  /**
+   * @brief Run an element-wise kernel over len elements, one bounded critical section per chunk
+   *
+   * Long kernels are split across both cores (see parallelSplit), each core
+   * running its part in chunks.
+   *
+   * @param len Number of elements
+   * @param kernel kernel(i, n) processes the elements [i..i + n)
+   * @param granule Chunks and parts are a multiple of it
+   */
+  template<typename Kernel>
+  inline void execDspChunked(const size_t len, Kernel kernel, const size_t granule = 16)
+  {
+    execDspChunkedParts(len, [&](const size_t i, const size_t n, const int part){kernel(i, n);}, granule);
+  }
+}
+
+#endif
@@ -0,0 +1,581 @@
+#ifndef _ESP_MATH_EXPRESSION_H_
+#define _ESP_MATH_EXPRESSION_H_
+
+#include "esp_platform.h"
+#include "esp_opt.h"
+#include "esp_fixed_point.h"
+#if ESP_MATH_DSP
+#include "dsp/div/dsps_div_esp.h"
+#endif
+#include <type_traits>
+
+/**
+ * @brief Lazy evaluation of Array arithmetic
+ *
+ * The arithmetic operators of Array do not compute anything: they return an
+ * expression object holding their operands. Arrays are held by reference,
+ * views and sub-expressions by value, so a chain such as a*b + c*d - e builds a small
+ * tree on the stack. The tree is evaluated when it is assigned to an Array
+ * (or used to construct one), in a single loop and into a single buffer.
+ *
+ * Every element follows the rules of the DSP kernel of the same operation
+ * (saturation, wrap around, frac shifts, and the rounding and overflow modes
+ * of fixedArithmetic() for int16 products and quotients), so chaining
+ * operators gives the same result as evaluating them one by one. When the expression is a single
+ * operation between arrays or views (or one of them and a constant) it is
+ * handed to the DSP kernel instead, with the strides of the views as steps.
+ *
+ * @note An expression must not outlive the arrays it refers to. Do not store
+ * it in an auto variable, assign it to an Array.
+ */
+
+namespace espmath{
+
+  template <typename T> class Array;
+  template <typename T> class ArrayView;
+  struct shape2D;
+
+  /**
+   * @brief Base class of every array expression
+   *
+   */
+  struct ArrayExpressionBase{};
+
+  /**
+   * @brief True for Array<T>, ArrayView<T> and array expressions
+   */
+  template<typename E> struct isArrayOperand : std::is_base_of<ArrayExpressionBase, E>{};
+  template<typename T> struct isArrayOperand<Array<T>> : std::true_type{};
+
+  /**
+   * @brief True for operands the DSP kernels can read directly: Array<T> and ArrayView<T>
+   */
+  template<typename E> struct isKernelOperand : std::false_type{};
+  template<typename T> struct isKernelOperand<Array<T>> : std::true_type{};
+  template<typename T> struct isKernelOperand<ArrayView<T>> : std::true_type{};
+
+  /**
+   * @brief Array operand of an expression
+   *
+   * It keeps the data pointer itself rather than a reference to the array,
+   * so the compiler knows the output buffer cannot move it while the
+   * expression is evaluated.
+   */
+  template<typename T>
+  class ArrayOperand
+  {
+  public:
+    typedef T value_type;
+
+    ArrayOperand(const Array<T>& array):_data(array.flatten),arrayShape(array.shape),fracBits(array.frac){}
+
+    T operator[](const size_t i) const {return _data[i];}
+    const T* data() const {return _data;}
+    size_t stride() const {return 1;}
+    const shape2D& shape() const {return arrayShape;}
+    uint8_t frac() const {return fracBits;}
+
+  private:
+    const T* _data;
+    const shape2D& arrayShape;
+    uint8_t fracBits;
+  };
+
+  /**
+   * @brief Type used to store an operand: Arrays become ArrayOperand
+   */
+  template<typename E> struct operandStorage{typedef E type;};
+  template<typename T> struct operandStorage<Array<T>>{typedef ArrayOperand<T> type;};
+
+#if ESP_MATH_DSP
+  /**
+   * @brief DSP kernels behind single operation expressions.
+   *
+   * y = x1 (op) x2 or y = x (op) c, where c is a constant. frac is the
+   * fractional bits of fixed point (int16_t and int32_t) arrays, formats the
+   * fractional bits of x1, x2 and y when they may differ. The steps are the
+   * distance, in elements, between two consecutive elements of each array.
+   */
+  namespace kernels{
+    void add(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void add(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void add(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void add(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void add(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+
+    void addc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void addc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void addc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void addc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void addc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void sub(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void sub(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void sub(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void sub(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void sub(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+
+    void subc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void subc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void subc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void subc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void subc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void csub(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void csub(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void csub(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void csub(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void csub(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void mul(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void mul(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void mul(const uint32_t* x1, const uint32_t* x2, uint32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void mul(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void mul(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+
+    void mulc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void mulc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void mulc(const uint32_t* x, const uint32_t c, uint32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void mulc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void mulc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void divc(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void divc(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void divc(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void divc(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void cdiv(const float* x, const float c, float* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void cdiv(const int32_t* x, const int32_t c, int32_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void cdiv(const int16_t* x, const int16_t c, int16_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+    void cdiv(const int8_t* x, const int8_t c, int8_t* y, const size_t len, const uint8_t frac, const int step_x = 1, const int step_y = 1);
+
+    void div(const float* x1, const float* x2, float* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void div(const int32_t* x1, const int32_t* x2, int32_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void div(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void div(const int8_t* x1, const int8_t* x2, int8_t* y, const size_t len, const uint8_t frac, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+
+    /* int16 operands of different formats are aligned inside the kernels */
+    void add(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void sub(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void mul(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+    void div(const int16_t* x1, const int16_t* x2, int16_t* y, const size_t len, const FixedFormats& formats, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1);
+
+    /* other types take the frac of the result */
+#define ESP_MATH_FORMATS_KERNEL(name)\
+    template<typename T>\
+    inline void name(const T* x1, const T* x2, T* y, const size_t len, const FixedFormats& formats, const int step_x1 = 1, const int step_x2 = 1, const int step_y = 1)\
+    {\
+      name(x1, x2, y, len, formats.y, step_x1, step_x2, step_y);\
+    }
+
+    ESP_MATH_FORMATS_KERNEL(add)
+    ESP_MATH_FORMATS_KERNEL(sub)
+    ESP_MATH_FORMATS_KERNEL(mul)
+    ESP_MATH_FORMATS_KERNEL(div)
+
+#undef ESP_MATH_FORMATS_KERNEL
+  }
+#endif
+
+  /**
+   * @brief Element-wise operations.
+   *
+   * apply() computes one element exactly as the DSP kernel does: float
+   * quotients come from the Newton-Raphson reciprocal of the kernels (x / c
+   * from 1/c), int8 and int16 additions and subtractions saturate, int16
+   * products and quotients are scaled by frac and rounded as fixedArithmetic() says,
+   * int32 products and quotients are scaled by frac on 64 bits, int32
+   * arithmetic wraps around. int16 operands of different formats are
+   * aligned as the *_q kernels do; other types use the frac of the result.
+   * kernel() runs the DSP kernel over whole arrays.
+   */
+  namespace op{
+
+    inline int8_t sat8(const int32_t value)
+    {
+      return (int8_t)(value > INT8_MAX ? INT8_MAX : (value < INT8_MIN ? INT8_MIN : value));
+    }
+
+    inline int16_t sat16(const int32_t value)
+    {
+      return (int16_t)(value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : value));
+    }
+
+    struct Add
+    {
+      static float apply(const float a, const float b, const uint8_t frac){return a + b;}
+      static int32_t apply(const int32_t a, const int32_t b, const uint8_t frac){return (int32_t)((uint32_t)a + (uint32_t)b);}
+      static uint32_t apply(const uint32_t a, const uint32_t b, const uint8_t frac){return a + b;}
+      static int16_t apply(const int16_t a, const int16_t b, const uint8_t frac){return sat16((int32_t)a + b);}
+      static int8_t apply(const int8_t a, const int8_t b, const uint8_t frac){return sat8((int32_t)a + b);}
+      static int16_t apply(const int16_t a, const int16_t b, const FixedFormats& formats)
+      {
+        return dsps_fixed_add_q_s16(a, formats.x1, b, formats.x2, formats.y, fixedArithmetic().mode());
+      }
+      template<typename T>
+      static T apply(const T a, const T b, const FixedFormats& formats){return apply(a, b, formats.y);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x1, const T* x2, T* y, const size_t len, const FixedFormats& formats,\
+                         const int step_x1, const int step_x2, const int step_y)
+      {
+        kernels::add(x1, x2, y, len, formats, step_x1, step_x2, step_y);
+      }
+#endif
+    };
+
+    struct Sub
+    {
+      static float apply(const float a, const float b, const uint8_t frac){return a - b;}
+      static int32_t apply(const int32_t a, const int32_t b, const uint8_t frac){return (int32_t)((uint32_t)a - (uint32_t)b);}
+      static uint32_t apply(const uint32_t a, const uint32_t b, const uint8_t frac){return a - b;}
+      static int16_t apply(const int16_t a, const int16_t b, const uint8_t frac){return sat16((int32_t)a - b);}
+      static int8_t apply(const int8_t a, const int8_t b, const uint8_t frac){return sat8((int32_t)a - b);}
+      static int16_t apply(const int16_t a, const int16_t b, const FixedFormats& formats)
+      {
+        return dsps_fixed_sub_q_s16(a, formats.x1, b, formats.x2, formats.y, fixedArithmetic().mode());
+      }
+      template<typename T>
+      static T apply(const T a, const T b, const FixedFormats& formats){return apply(a, b, formats.y);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x1, const T* x2, T* y, const size_t len, const FixedFormats& formats,\
+                         const int step_x1, const int step_x2, const int step_y)
+      {
+        kernels::sub(x1, x2, y, len, formats, step_x1, step_x2, step_y);
+      }
+#endif
+    };
+
+    struct Mul
+    {
+      static float apply(const float a, const float b, const uint8_t frac){return a * b;}
+      static int32_t apply(const int32_t a, const int32_t b, const uint8_t frac){return (int32_t)(((int64_t)a * b) >> frac);}
+      static uint32_t apply(const uint32_t a, const uint32_t b, const uint8_t frac){return a * b;}
+      static int16_t apply(const int16_t a, const int16_t b, const uint8_t frac)
+      {
+        const FixedArithmetic& arithmetic = fixedArithmetic();
+        return arithmetic.plain() ? (int16_t)(((int32_t)a * b) >> frac) : dsps_fixed_mul_s16(a, b, frac, arithmetic.mode());
+      }
+      static int8_t apply(const int8_t a, const int8_t b, const uint8_t frac){return (int8_t)((int32_t)a * b);}
+      static int16_t apply(const int16_t a, const int16_t b, const FixedFormats& formats)
+      {
+        return dsps_fixed_mul_q_s16(a, formats.x1, b, formats.x2, formats.y, fixedArithmetic().mode());
+      }
+      template<typename T>
+      static T apply(const T a, const T b, const FixedFormats& formats){return apply(a, b, formats.y);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x1, const T* x2, T* y, const size_t len, const FixedFormats& formats,\
+                         const int step_x1, const int step_x2, const int step_y)
+      {
+        kernels::mul(x1, x2, y, len, formats, step_x1, step_x2, step_y);
+      }
+#endif
+    };
+
+    struct Div
+    {
+#if ESP_MATH_DSP
+      /* The Newton-Raphson quotient of the float kernels */
+      static float apply(const float a, const float b, const uint8_t frac){return dsps_div_nr_f32(a, b);}
+#else
+      static float apply(const float a, const float b, const uint8_t frac){return a / b;}
+#endif
+      static int32_t apply(const int32_t a, const int32_t b, const uint8_t frac){return (int32_t)(((int64_t)a << frac) / b);}
+      static int16_t apply(const int16_t a, const int16_t b, const uint8_t frac)
+      {
+        const FixedArithmetic& arithmetic = fixedArithmetic();
+        return arithmetic.plain() ? (int16_t)(((int32_t)a << frac) / b) : dsps_fixed_div_s16(a, b, frac, arithmetic.mode());
+      }
+      static int8_t apply(const int8_t a, const int8_t b, const uint8_t frac){return (int8_t)((int32_t)a / b);}
+      static int16_t apply(const int16_t a, const int16_t b, const FixedFormats& formats)
+      {
+        return dsps_fixed_div_q_s16(a, formats.x1, b, formats.x2, formats.y, fixedArithmetic().mode());
+      }
+      template<typename T>
+      static T apply(const T a, const T b, const FixedFormats& formats){return apply(a, b, formats.y);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x1, const T* x2, T* y, const size_t len, const FixedFormats& formats,\
+                         const int step_x1, const int step_x2, const int step_y)
+      {
+        kernels::div(x1, x2, y, len, formats, step_x1, step_x2, step_y);
+      }
+#endif
+    };
+
+    /* x + c */
+    struct AddC : Add
+    {
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::addc(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+
+    /* x - c, computed as x + (-c) */
+    struct SubC
+    {
+      template<typename T>
+      static T apply(const T x, const T c, const uint8_t frac){return Add::apply(x, (T)(-c), frac);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::subc(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+
+    /* c - x */
+    struct CSub
+    {
+      template<typename T>
+      static T apply(const T x, const T c, const uint8_t frac){return Sub::apply(c, x, frac);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::csub(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+
+    /* x * c. Unlike x1 * x2, int16 products saturate in the plain mode. */
+    struct MulC
+    {
+      static float apply(const float x, const float c, const uint8_t frac){return x * c;}
+      static int32_t apply(const int32_t x, const int32_t c, const uint8_t frac){return Mul::apply(x, c, frac);}
+      static uint32_t apply(const uint32_t x, const uint32_t c, const uint8_t frac){return x * c;}
+      static int16_t apply(const int16_t x, const int16_t c, const uint8_t frac)
+      {
+        const FixedArithmetic& arithmetic = fixedArithmetic();
+        return arithmetic.plain() ? sat16(((int32_t)x * c) >> frac) : dsps_fixed_mul_s16(x, c, frac, arithmetic.mode());
+      }
+      static int8_t apply(const int8_t x, const int8_t c, const uint8_t frac){return Mul::apply(x, c, frac);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::mulc(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+
+    /* x / c */
+    struct DivC : Div
+    {
+#if ESP_MATH_DSP
+      /* Float elements are multiplied by 1/c, as the kernel does */
+      using Div::apply;
+      static float apply(const float x, const float c, const uint8_t frac){return x * (1.0f / c);}
+#endif
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::divc(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+
+    /* c / x */
+    struct CDiv
+    {
+      template<typename T>
+      static T apply(const T x, const T c, const uint8_t frac){return Div::apply(c, x, frac);}
+#if ESP_MATH_DSP
+      template<typename T>
+      static void kernel(const T* x, const T c, T* y, const size_t len, const uint8_t frac,\
+                         const int step_x, const int step_y)
+      {
+        kernels::cdiv(x, c, y, len, frac, step_x, step_y);
+      }
+#endif
+    };
+  }
+
+  /**
+   * @brief Element-wise operation between two array operands
+   *
+   * @tparam Op Operation (see namespace op)
+   * @tparam L Left operand: Array or expression
+   * @tparam R Right operand: Array or expression
+   */
+  template<class Op, class L, class R>
+  class ArrayBinaryExpression : public ArrayExpressionBase
+  {
+  public:
+    typedef typename L::value_type value_type;
+    static_assert(std::is_same<value_type, typename R::value_type>::value, "Operands must have the same type");
+
+    ArrayBinaryExpression(const L& l, const R& r):left(l),right(r),fracs(resultFormats(left.frac(), right.frac()))
+    {
+      assert(left.shape() == right.shape());
+    }
+
+    value_type operator[](const size_t i) const
+    {
+      return fracs.same() ? Op::apply(left[i], right[i], fracs.y) : Op::apply(left[i], right[i], fracs);
+    }
+
+    const shape2D& shape() const {return left.shape();}
+    uint8_t frac() const {return fracs.y;}
+    const FixedFormats& formats() const {return fracs;}
+
+    typename operandStorage<L>::type left;
+    typename operandStorage<R>::type right;
+  private:
+    FixedFormats fracs;
+
+    /**
+     * @brief int16 operands of different frac give the format chosen by
+     * fixedArithmetic().result; everything else keeps the frac of the left operand.
+     */
+    static FixedFormats resultFormats(const uint8_t frac_x1, const uint8_t frac_x2)
+    {
+      if (!std::is_same<value_type, int16_t>::value || frac_x1 == frac_x2)
+        return FixedFormats{frac_x1, frac_x1, frac_x1};
+      return FixedFormats{frac_x1, frac_x2, fixedArithmetic().format(frac_x1, frac_x2)};
+    }
+  };
+
+  /**
+   * @brief Element-wise operation between an array operand and a constant
+   *
+   * @tparam Op Operation (see namespace op)
+   * @tparam E Array or expression
+   */
+  template<class Op, class E>
+  class ArrayScalarExpression : public ArrayExpressionBase
+  {
+  public:
+    typedef typename E::value_type value_type;
+
+    ArrayScalarExpression(const E& e, const value_type c):operand(e),constant(c),fracBits(operand.frac()){}
+
+    value_type operator[](const size_t i) const
+    {
+      return Op::apply(operand[i], constant, fracBits);
+    }
+
+    const shape2D& shape() const {return operand.shape();}
+    uint8_t frac() const {return fracBits;}
+
+    typename operandStorage<E>::type operand;
+    value_type constant;
+  private:
+    uint8_t fracBits;
+  };
+
+  /**
+   * @brief Evaluate an expression into y element by element, without the
+   * DSP kernels. The parameters are those of evaluate().
+   */
+  template<class E>
+  inline void evaluateElements(const E& expression, typename E::value_type* y, const size_t step_y = 1)
+  {
+    const E local = expression; /* y cannot alias a local copy */
+    const size_t len = local.shape().size;
+    if (step_y == 1)
+    {
+      for (size_t i = 0; i < len; i++)
+        y[i] = local[i];
+    }
+    else
+    {
+      for (size_t i = 0; i < len; i++)
+        y[i*step_y] = local[i];
+    }
+  }
+
+  /**
+   * @brief Evaluate an expression into y, in one pass.
+   *
+   * @param expression
+   * @param y Output buffer, with room for expression.shape().size elements.
+   * It may be one of the arrays of the expression.
+   * @param step_y Distance, in elements, between two consecutive outputs.
+   */
+  template<class E>
+  inline void evaluate(const E& expression, typename E::value_type* y, const size_t step_y = 1)
+  {
+    evaluateElements(expression, y, step_y);
+  }
+
+#if ESP_MATH_DSP
+  /**
+   * @brief True when the kernels can run on these buffers.
+   *
+   * With every step equal to 1 the kernels load and store 16 bytes at a
+   * time, which needs ALIGNMENT aligned addresses. Views starting inside an
+   * array (slice(1, ...), the rows of a matrix whose rows are not a multiple
+   * of 16 bytes) are not, so they are evaluated element by element instead.
+   */
+  inline bool kernelAligned(const void* x1, const void* x2, const void* y, const int step_x1, const int step_x2, const int step_y)
+  {
+    if (step_x1 != 1 || step_x2 != 1 || step_y != 1)
+      return true;
+    return !(((uintptr_t)x1 | (uintptr_t)x2 | (uintptr_t)y) & (ALIGNMENT - 1));
+  }
+
+  template<class Op, class L, class R>
+  inline typename std::enable_if<isKernelOperand<L>::value && isKernelOperand<R>::value>::type
+  evaluate(const ArrayBinaryExpression<Op, L, R>& expression, typename L::value_type* y, const size_t step_y = 1)
+  {
+    if (!kernelAligned(expression.left.data(), expression.right.data(), y,\
+                       (int)expression.left.stride(), (int)expression.right.stride(), (int)step_y))
+      return evaluateElements(expression, y, step_y);
+    Op::kernel(expression.left.data(), expression.right.data(), y, expression.shape().size, expression.formats(),\
+               (int)expression.left.stride(), (int)expression.right.stride(), (int)step_y);
+  }
+
+  template<class Op, class E>
+  inline typename std::enable_if<isKernelOperand<E>::value>::type
+  evaluate(const ArrayScalarExpression<Op, E>& expression, typename E::value_type* y, const size_t step_y = 1)
+  {
+    if (!kernelAligned(expression.operand.data(), y, y, (int)expression.operand.stride(), (int)step_y, (int)step_y))
+      return evaluateElements(expression, y, step_y);
+    Op::kernel(expression.operand.data(), expression.constant, y, expression.shape().size, expression.frac(),\
+               (int)expression.operand.stride(), (int)step_y);
+  }
+#endif
+
+#define ESP_MATH_ARRAY_OPERATOR(symbol, Op, OpC, COp)\
+  template<class L, class R>\
+  inline typename std::enable_if<isArrayOperand<L>::value && isArrayOperand<R>::value, ArrayBinaryExpression<op::Op, L, R>>::type\
+  operator symbol(const L& left, const R& right)\
+  {\
+    return ArrayBinaryExpression<op::Op, L, R>(left, right);\
+  }\
+  template<class E>\
+  inline typename std::enable_if<isArrayOperand<E>::value, ArrayScalarExpression<op::OpC, E>>::type\
+  operator symbol(const E& operand, const typename E::value_type constant)\
+  {\
+    return ArrayScalarExpression<op::OpC, E>(operand, constant);\
+  }\
+  template<class E>\
+  inline typename std::enable_if<isArrayOperand<E>::value, ArrayScalarExpression<op::COp, E>>::type\
+  operator symbol(const typename E::value_type constant, const E& operand)\
+  {\
+    return ArrayScalarExpression<op::COp, E>(operand, constant);\
+  }
+
+  ESP_MATH_ARRAY_OPERATOR(+, Add, AddC, AddC)
+  ESP_MATH_ARRAY_OPERATOR(-, Sub, SubC, CSub)
+  ESP_MATH_ARRAY_OPERATOR(*, Mul, MulC, MulC)
+  ESP_MATH_ARRAY_OPERATOR(/, Div, DivC, CDiv)
+
+#undef ESP_MATH_ARRAY_OPERATOR
+}
+
+#endif
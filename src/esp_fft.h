@@ -0,0 +1,309 @@
+#ifndef _ESP_FFT_H_
+#define _ESP_FFT_H_
+
+#include "esp_platform.h"
+#include "esp_array.h"
+#include <type_traits>
+#include <utility>
+
+namespace espmath{
+  /**
+   * @brief Twiddles of the n points transforms, computed the first time a size is used
+   *
+   * tw[2i] + j*tw[2i + 1] = exp(-2*pi*j*i/n); i=[0..max(1, 3n/4)), which
+   * covers the radix-4 butterflies of an n points FFT and the split of an n
+   * points real FFT. int16_t tables are Q15.
+   *
+   * @note The tables are kept for the lifetime of the program, one per size
+   * and type, and shared by every Fft and Rfft of that size.
+   *
+   * @tparam T float or int16_t
+   * @param n Number of points, a power of 2
+   * @return const T* Twiddle table
+   */
+  template<typename T> const T* fftTwiddles(const size_t n)
+  {
+    static Array<T> tables[8*sizeof(size_t)];
+    size_t log2n = 0;
+    while (((size_t)1 << log2n) < n)
+      log2n++;
+    Array<T>& table = tables[log2n];
+    if (table.flatten == NULL)
+    {
+      const size_t count = 3*n/4 > 0 ? 3*n/4 : 1;
+      table = Array<T>(std::is_integral<T>::value ? 15 : 0, shape2D(1, 2*count));
+      for (size_t i = 0; table.flatten && i < count; i++)
+      {
+        const double angle = 2*M_PI*i/n;
+        if (std::is_integral<T>::value)
+        {
+          table.flatten[2*i] = (T)lround(cos(angle)*INT16_MAX);
+          table.flatten[2*i + 1] = (T)lround(-sin(angle)*INT16_MAX);
+        }
+        else
+        {
+          table.flatten[2*i] = (T)cos(angle);
+          table.flatten[2*i + 1] = (T)-sin(angle);
+        }
+      }
+    }
+    return table.flatten;
+  }
+
+  /**
+   * @brief In place complex FFT of a power of 2 size
+   *
+   * X[m] = sum(x[i]*exp(-2*pi*j*i*m/n)); i=[0..n)
+   *
+   * The data is n complex values (re, im) one after the other: a (n, 2)
+   * array or 2n elements. The input is put in bit reversed order, then
+   * transformed by radix-4 passes (and a radix-2 one when log2(n) is odd) on
+   * the twiddles returned by fftTwiddles, computed once per size.
+   *
+   * int16_t transforms (Q15 or any other fixed point format) return X/n, each
+   * pass scaling its outputs down so that nothing overflows: the output keeps
+   * the format of the input.
+   *
+   * @note float and int16_t transforms make use of DSP instructions.
+   *
+   * @tparam T float or int16_t
+   */
+  template<typename T = float> class Fft
+  {
+  public:
+    /**
+     * @brief Construct a new Fft object
+     *
+     * @param n Number of complex values, a power of 2
+     */
+    explicit Fft(const size_t n):_n(n),_twiddles(NULL)
+    {
+      ESP_ERROR_CHECK(n == 0 || (n & (n - 1))); //"the FFT size must be a power of 2!"
+      _twiddles = fftTwiddles<T>(n);
+    }
+
+    /**
+     * @brief Transform n complex values in place
+     *
+     * @param data 2n elements, (re, im) pairs
+     */
+    void transform(T* data) const
+    {
+      bitReverse(data);
+      butterflies(data);
+    }
+
+    /**
+     * @brief Transform n complex values in place
+     *
+     * @param data Array of 2n elements, (re, im) pairs
+     */
+    void transform(Array<T>& data) const
+    {
+      assert(data.shape.size == 2*_n);
+      transform(data.flatten);
+    }
+
+    size_t size() const {return _n;}
+
+  private:
+    size_t _n;
+    const T* _twiddles;
+
+    /**
+     * @brief Swap the complex values whose indexes are bit reversed
+     */
+    void bitReverse(T* data) const
+    {
+      for (size_t i = 1, j = 0; i < _n; i++)
+      {
+        size_t bit = _n >> 1;
+        for (; j & bit; bit >>= 1)
+          j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+          std::swap(data[2*i], data[2*j]);
+          std::swap(data[2*i + 1], data[2*j + 1]);
+        }
+      }
+    }
+
+    /**
+     * @brief Radix-2 and radix-4 passes, the order of the dsps_fft4r kernels
+     */
+    void butterflies(T* data) const
+    {
+      typedef typename ArrayStats<T>::sum_t sum_t;
+      const sum_t one = std::is_integral<T>::value ? 32768 : 1; /* Q15 twiddles */
+      const size_t n = _n;
+      size_t h = 1;
+      if (n > 1 && !(n & 0x55555555))
+      {
+        for (size_t i = 0; i < 2*n; i += 4)
+        {
+          const sum_t ar = data[i], ai = data[i + 1], br = data[i + 2], bi = data[i + 3];
+          data[i] = narrow(ar + br, 2);
+          data[i + 1] = narrow(ai + bi, 2);
+          data[i + 2] = narrow(ar - br, 2);
+          data[i + 3] = narrow(ai - bi, 2);
+        }
+        h = 2;
+      }
+      for (size_t groups = n/(4*h); groups; h *= 4, groups /= 4)
+        for (size_t k = 0; k < h; k++)
+        {
+          const T *w1 = _twiddles + 2*k*groups, *w2 = _twiddles + 4*k*groups, *w3 = _twiddles + 6*k*groups;
+          for (T *p = data + 2*k; p < data + 2*n; p += 8*h)
+          {
+            T *p1 = p + 2*h, *p2 = p + 4*h, *p3 = p + 6*h;
+            const sum_t br = ((sum_t)w2[0]*p1[0] - (sum_t)w2[1]*p1[1])/one, bi = ((sum_t)w2[0]*p1[1] + (sum_t)w2[1]*p1[0])/one;
+            const sum_t cr = ((sum_t)w1[0]*p2[0] - (sum_t)w1[1]*p2[1])/one, ci = ((sum_t)w1[0]*p2[1] + (sum_t)w1[1]*p2[0])/one;
+            const sum_t dr = ((sum_t)w3[0]*p3[0] - (sum_t)w3[1]*p3[1])/one, di = ((sum_t)w3[0]*p3[1] + (sum_t)w3[1]*p3[0])/one;
+            const sum_t t0r = p[0] + br, t0i = p[1] + bi, t1r = p[0] - br, t1i = p[1] - bi;
+            const sum_t t2r = cr + dr, t2i = ci + di, t3r = ci - di, t3i = dr - cr; /* t3 = -j(c - d) */
+            p[0] = narrow(t0r + t2r, 4);
+            p[1] = narrow(t0i + t2i, 4);
+            p2[0] = narrow(t0r - t2r, 4);
+            p2[1] = narrow(t0i - t2i, 4);
+            p1[0] = narrow(t1r + t3r, 4);
+            p1[1] = narrow(t1i + t3i, 4);
+            p3[0] = narrow(t1r - t3r, 4);
+            p3[1] = narrow(t1i - t3i, 4);
+          }
+        }
+    }
+
+    /**
+     * @brief Back to T. Fixed point values are divided by scale and saturated.
+     */
+    static T narrow(typename ArrayStats<T>::sum_t value, const int scale)
+    {
+      if (!std::is_integral<T>::value)
+        return (T)value;
+      value /= scale;
+      return (T)(value > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() :\
+                (value < std::numeric_limits<T>::lowest() ? std::numeric_limits<T>::lowest() : value));
+    }
+  };
+
+  /**
+   * @brief In place FFT of n real values, n being a power of 2
+   *
+   * The n reals are transformed as n/2 complex values (x[2i] + j*x[2i + 1])
+   * and the two interleaved spectra are split afterwards. The spectrum of a
+   * real signal being symmetric, only X[0..n/2] is returned, packed in the n
+   * elements of the input:
+   *
+   * {X[0], X[n/2], re(X[1]), im(X[1]), ..., re(X[n/2 - 1]), im(X[n/2 - 1])}
+   *
+   * X[0] and X[n/2] are real. As with Fft, int16_t transforms return X/n in
+   * the format of the input.
+   *
+   * @note float and int16_t transforms make use of DSP instructions.
+   *
+   * @tparam T float or int16_t
+   */
+  template<typename T = float> class Rfft
+  {
+  public:
+    /**
+     * @brief Construct a new Rfft object
+     *
+     * @param n Number of real values, a power of 2 greater than 1
+     */
+    explicit Rfft(const size_t n):_fft(n > 1 ? n/2 : 1),_n(n),_twiddles(NULL)
+    {
+      ESP_ERROR_CHECK(n < 2 || (n & (n - 1))); //"the FFT size must be a power of 2!"
+      _twiddles = fftTwiddles<T>(n);
+    }
+
+    /**
+     * @brief Transform n real values in place
+     *
+     * @param data n elements, receives the packed spectrum
+     */
+    void transform(T* data) const
+    {
+      _fft.transform(data);
+      split(data);
+    }
+
+    /**
+     * @brief Transform n real values in place
+     *
+     * @param data Array of n elements, receives the packed spectrum
+     */
+    void transform(Array<T>& data) const
+    {
+      assert(data.shape.size == _n);
+      transform(data.flatten);
+    }
+
+    size_t size() const {return _n;}
+
+  private:
+    Fft<T> _fft;
+    size_t _n;
+    const T* _twiddles;
+
+    /**
+     * @brief X[k] = (Z[k] + conj(Z[m - k]))/2 - j*W^k*(Z[k] - conj(Z[m - k]))/2,
+     * X[m - k] = conj((Z[k] + conj(Z[m - k]))/2 + j*W^k*(Z[k] - conj(Z[m - k]))/2)
+     * Z being the spectrum of the m = n/2 complex values.
+     */
+    void split(T* data) const
+    {
+      typedef typename ArrayStats<T>::sum_t sum_t;
+      const bool fixed = std::is_integral<T>::value;
+      const sum_t one = fixed ? 32768 : 1; /* Q15 twiddles */
+      const int scale = fixed ? 4 : 2;     /* fixed point keeps X/n, the spectrum of Z being Z/m */
+      const size_t m = _n/2;
+      const sum_t z0r = data[0], z0i = data[1];
+      data[0] = narrow(2*(z0r + z0i), scale);
+      data[1] = narrow(2*(z0r - z0i), scale);
+      for (size_t k = 1; k <= m/2; k++)
+      {
+        T *zk = data + 2*k, *zm = data + 2*(m - k);
+        const T *w = _twiddles + 2*k;
+        const sum_t er = (sum_t)zk[0] + zm[0], ei = (sum_t)zk[1] - zm[1]; /* 2*even */
+        const sum_t odr = (sum_t)zk[1] + zm[1], odi = (sum_t)zm[0] - zk[0]; /* 2*odd */
+        const sum_t pr = ((sum_t)w[0]*odr - (sum_t)w[1]*odi)/one, pi = ((sum_t)w[0]*odi + (sum_t)w[1]*odr)/one;
+        zk[0] = narrow(er + pr, scale);
+        zk[1] = narrow(ei + pi, scale);
+        zm[0] = narrow(er - pr, scale);
+        zm[1] = narrow(pi - ei, scale);
+      }
+    }
+
+    /**
+     * @brief Back to T, divided by scale. Fixed point values are saturated.
+     */
+    static T narrow(typename ArrayStats<T>::sum_t value, const int scale)
+    {
+      value /= scale;
+      if (!std::is_integral<T>::value)
+        return (T)value;
+      return (T)(value > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() :\
+                (value < std::numeric_limits<T>::lowest() ? std::numeric_limits<T>::lowest() : value));
+    }
+  };
+
+#if ESP_MATH_DSP
+
+  template<>
+  inline void Fft<float>::butterflies(float* data) const
+  {
+    exec_dsp(dsps_fft4r_f32_esp, data, _n, _twiddles);
+  }
+
+  template<>
+  inline void Fft<int16_t>::butterflies(int16_t* data) const
+  {
+    exec_dsp(dsps_fft4r_s16_esp, data, _n, _twiddles);
+  }
+
+#endif
+}
+
+#endif
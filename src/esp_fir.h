@@ -0,0 +1,158 @@
+#ifndef _ESP_FIR_H_
+#define _ESP_FIR_H_
+
+#include "esp_platform.h"
+#include "esp_array.h"
+
+namespace espmath{
+  /**
+   * @brief Streaming FIR filter, optionally decimating
+   *
+   * y[n] = sum(h[k]*x[n*D + D - 1 - k]); k=[0..taps)
+   *
+   * The filter keeps its delay line between calls, so a continuous stream is
+   * processed in blocks of any size, in place, without allocating: the buffers
+   * are allocated once by the constructor. With a decimation D > 1, only one
+   * output every D inputs is computed.
+   *
+   * The delay line (the last taps - 1 inputs) is kept contiguous in front of
+   * the incoming inputs, so every output is a single dot product with the
+   * aligned coefficients. It is moved back to the front once per chunk of
+   * blockSize inputs.
+   *
+   * For int16_t filters (Q15 or any other fixed point format), the
+   * coefficients carry their frac: the products are accumulated on 40 bits,
+   * shifted right by it and saturated, so the output keeps the format of the input.
+   *
+   * @note float and int16_t filters make use of DSP instructions.
+   *
+   * @tparam T Filter type
+   */
+  template<typename T = float> class Fir
+  {
+  public:
+    /**
+     * @brief Construct a new Fir object with a zeroed delay line
+     *
+     * @param coefficients Filter coefficients, h[0] applies to the newest input.
+     * @param decimation Inputs per output.
+     * @param blockSize Inputs filtered per kernel call, longer blocks are split.
+     */
+    Fir(const Array<T>& coefficients, const size_t decimation = 1, const size_t blockSize = 256):
+      _coeffs(coefficients.frac, shape2D(1, coefficients.shape.size)),
+      _delay(shape2D(1, coefficients.shape.size + decimation + blockSize)),
+      _decimation(decimation),
+      _blockSize(blockSize)
+    {
+      ESP_ERROR_CHECK(coefficients.shape.size == 0); //"the filter needs coefficients!"
+      ESP_ERROR_CHECK(decimation == 0 || blockSize == 0);
+      const size_t taps = coefficients.shape.size;
+      for (size_t i = 0; _coeffs.flatten && i < taps; i++)
+        _coeffs.flatten[i] = coefficients.flatten[taps - 1 - i];
+      reset();
+    }
+
+    /**
+     * @brief Filter a block of inputs
+     *
+     * @param input Inputs
+     * @param output Outputs, len/D of them (plus one if an output was pending).
+     * It may be the input buffer.
+     * @param len Number of inputs
+     * @return size_t Number of outputs
+     */
+    size_t process(const T* input, T* output, size_t len)
+    {
+      const size_t taps = _coeffs.shape.size;
+      T* const line = _delay.flatten;
+      size_t produced = 0;
+      if (!line || !_coeffs.flatten)
+        return 0;
+      while (len)
+      {
+        const size_t n = len < _blockSize ? len : _blockSize;
+        memcpy(line + _history, input, n*sizeof(T));
+        const size_t total = _history + n;
+        const size_t needed = taps + _decimation - 1; /* inputs of the next output */
+        const size_t outputs = total >= needed ? (total - needed)/_decimation + 1 : 0;
+        if (outputs)
+          filter(line + _decimation - 1, output + produced, outputs);
+        _history = total - outputs*_decimation;
+        memmove(line, line + outputs*_decimation, _history*sizeof(T));
+        input += n;
+        len -= n;
+        produced += outputs;
+      }
+      return produced;
+    }
+
+    /**
+     * @brief Filter a block in place
+     *
+     * With a decimation, the block is shrunk to the outputs (without allocating).
+     *
+     * @param block One row array
+     * @return size_t Number of outputs
+     */
+    size_t process(Array<T>& block)
+    {
+      const size_t outputs = process(block.flatten, block.flatten, block.shape.size);
+      if (outputs != block.shape.size)
+        block.resize(outputs);
+      return outputs;
+    }
+
+    /**
+     * @brief Clear the delay line, as if the filter had only seen zeros
+     */
+    void reset()
+    {
+      _history = _coeffs.shape.size - 1;
+      if (_delay.flatten)
+        memset(_delay.flatten, 0, _history*sizeof(T));
+    }
+
+    size_t taps() const {return _coeffs.shape.size;}
+    size_t decimation() const {return _decimation;}
+
+  private:
+    Array<T> _coeffs; /* Time reversed coefficients */
+    Array<T> _delay;  /* Delay line followed by the inputs being filtered */
+    size_t _decimation;
+    size_t _blockSize;
+    size_t _history = 0; /* Inputs at the front of _delay: taps - 1, plus the ones of the pending output */
+
+    /**
+     * @brief y[n] = sum(x[n*D + m]*coeffs[m]); m=[0..taps), n=[0..len)
+     */
+    void filter(const T* x, T* y, const size_t len) const
+    {
+      const size_t taps = _coeffs.shape.size;
+      for (size_t n = 0; n < len; n++, x += _decimation)
+      {
+        typename ArrayStats<T>::sum_t acc = 0;
+        for (size_t m = 0; m < taps; m++)
+          acc += (typename ArrayStats<T>::sum_t)x[m]*_coeffs.flatten[m];
+        y[n] = (T)(acc/((int64_t)1 << _coeffs.frac));
+      }
+    }
+  };
+
+#if ESP_MATH_DSP
+
+  template<>
+  inline void Fir<float>::filter(const float* x, float* y, const size_t len) const
+  {
+    exec_dsp(dsps_fird_f32_esp, x, _coeffs, y, len, _coeffs.shape.size, _decimation);
+  }
+
+  template<>
+  inline void Fir<int16_t>::filter(const int16_t* x, int16_t* y, const size_t len) const
+  {
+    exec_dsp(dsps_fird_s16_esp, x, _coeffs, y, len, _coeffs.shape.size, _decimation, _coeffs.frac);
+  }
+
+#endif
+}
+
+#endif
@@ -1,20 +1,166 @@
 #ifndef _ESP_FIXED_POINT_H_
 #define _ESP_FIXED_POINT_H_
 
-#include <Arduino.h>
+#include "esp_platform.h"
 #include "esp_ansi.h"
 #include "esp_opt.h"
 #include "dsp/fixed/converter.h"
 #include "dsp/mulc/dsps_mulc_esp.h"
 #include "dsp/divc/dsps_divc_esp.h"
+#include "dsp/fixed/dsps_fixed_mode.h"
+#include <type_traits>
+#include <limits>
 
 #define FP_MUL(x, y, f) ((((long)x) * (y)) >> (f))
 #define FP_DIV(x, y, f) ((((long)x) << (f)) / (y))
 
+/* FP_MUL and FP_DIV with a DSPS_FIXED_* rounding and overflow mode. A zero
+   divisor gives the largest quotient of the sign of x (0 for 0/0) instead of trapping */
+#define FP_MUL_MODE(x, y, f, mode) dsps_fixed_mul_s16((x), (y), (f), (mode))
+#define FP_DIV_MODE(x, y, f, mode) ((y) ? dsps_fixed_div_s16((x), (y), (f), (mode)) : FP_DIV_ZERO(x))
+#define FP_DIV_ZERO(x) ((int16_t)((x) > 0 ? INT16_MAX : ((x) < 0 ? INT16_MIN : 0)))
+
+/**
+ * @brief Default rounding and overflow modes of int16 fixed point arithmetic
+ * (DSPS_FIXED_TRUNCATE, DSPS_FIXED_NEAREST or DSPS_FIXED_CONVERGENT and
+ * DSPS_FIXED_WRAP or DSPS_FIXED_SATURATE)
+ */
+#ifndef ESP_MATH_FIXED_ROUNDING
+#define ESP_MATH_FIXED_ROUNDING DSPS_FIXED_TRUNCATE
+#endif
+
+#ifndef ESP_MATH_FIXED_OVERFLOW
+#define ESP_MATH_FIXED_OVERFLOW DSPS_FIXED_WRAP
+#endif
+
+/**
+ * @brief Default format of int16 results whose operands have different frac
+ * (0 left operand, 1 finer, 2 coarser: see espmath::FixedResult)
+ */
+#ifndef ESP_MATH_FIXED_RESULT
+#define ESP_MATH_FIXED_RESULT 0
+#endif
+
 namespace espmath{
+  /**
+   * @brief Rounding of the products and quotients that drop frac bits.
+   *
+   * The values are the DSPS_FIXED_* codes taken by the *_s16_mode kernels.
+   */
+  enum FixedRounding
+  {
+    FIXED_TRUNCATE = DSPS_FIXED_TRUNCATE,    /* products toward -inf, quotients toward zero */
+    FIXED_NEAREST = DSPS_FIXED_NEAREST,      /* to nearest, halves away from zero (up for products) */
+    FIXED_CONVERGENT = DSPS_FIXED_CONVERGENT /* to nearest, halves to even */
+  };
+
+  /**
+   * @brief What happens to results that do not fit 16 bits
+   */
+  enum FixedOverflow
+  {
+    FIXED_WRAP = DSPS_FIXED_WRAP,        /* the low 16 bits are kept */
+    FIXED_SATURATE = DSPS_FIXED_SATURATE /* clamped to [INT16_MIN, INT16_MAX] */
+  };
+
+  /**
+   * @brief Format of the result of two Array<int16_t> with different frac
+   */
+  enum FixedResult
+  {
+    FIXED_RESULT_LEFT = 0,   /* the frac of the left operand */
+    FIXED_RESULT_FINER = 1,  /* the larger frac, more precision */
+    FIXED_RESULT_COARSER = 2 /* the smaller frac, more range */
+  };
+
+  /**
+   * @brief Fractional parts of the two operands and of the result of an operation
+   */
+  struct FixedFormats
+  {
+    uint8_t x1;
+    uint8_t x2;
+    uint8_t y;
+
+    /**
+     * @brief True when no alignment is needed
+     */
+    bool same() const {return x1 == x2 && x2 == y;}
+  };
+
+  /**
+   * @brief Rounding, overflow and result format of int16 fixed point
+   * arithmetic, changeable at runtime
+   */
+  struct FixedArithmetic
+  {
+    FixedOverflow overflow;
+    FixedRounding rounding;
+    FixedResult result;
+
+    /**
+     * @brief The DSPS_FIXED_* mode of the kernels
+     */
+    int mode() const {return overflow | rounding;}
+
+    /**
+     * @brief True for wrap and truncate, the results of the plain DSP kernels
+     */
+    bool plain() const {return mode() == (DSPS_FIXED_WRAP | DSPS_FIXED_TRUNCATE);}
+
+    /**
+     * @brief frac of the result of operands in Q(frac_x1) and Q(frac_x2)
+     */
+    uint8_t format(const uint8_t frac_x1, const uint8_t frac_x2) const
+    {
+      if (result == FIXED_RESULT_FINER)
+        return frac_x1 > frac_x2 ? frac_x1 : frac_x2;
+      if (result == FIXED_RESULT_COARSER)
+        return frac_x1 < frac_x2 ? frac_x1 : frac_x2;
+      return frac_x1;
+    }
+  };
+
+  /**
+   * @brief Rounding, overflow and result format of FixedPoint and
+   * Array<int16_t> arithmetic, set with ESP_MATH_FIXED_ROUNDING,
+   * ESP_MATH_FIXED_OVERFLOW and ESP_MATH_FIXED_RESULT.
+   *
+   * Products and quotients of Array<int16_t> run the *_s16_mode kernels,
+   * which round and saturate as they store, whenever the mode is not wrap
+   * and truncate. Additions and subtractions of Array<int16_t> always
+   * saturate, as the DSP instructions do.
+   *
+   * Array<int16_t> operands with different frac are aligned inside the
+   * kernels, and the result takes the frac chosen by result. Compound
+   * assignments (+=, -=, *=, /=) keep the frac of the destination.
+   *
+   * e.g. fixedArithmetic().overflow = FIXED_SATURATE;
+   *
+   * @note With wrap and truncate, array * constant keeps the saturating
+   * vector path of its plain kernel.
+   *
+   * @return FixedArithmetic&
+   */
+  inline FixedArithmetic& fixedArithmetic()
+  {
+    static FixedArithmetic config = {(FixedOverflow)ESP_MATH_FIXED_OVERFLOW, (FixedRounding)ESP_MATH_FIXED_ROUNDING, (FixedResult)ESP_MATH_FIXED_RESULT};
+    return config;
+  }
+
   /**
    * @brief Fixed Point Representation
    * 
+   * Mixed operations with floats stay on integers: the float operand is
+   * converted to the format of the fixed one (at compile time for
+   * constants, toFixed being constexpr), and products and quotients with it
+   * are rounded to nearest. An operand out of the range of that format is
+   * taken in the finest format that holds it. Integer operands are not
+   * converted at all.
+   *
+   * Operations between two FixedPoint round and overflow as
+   * fixedArithmetic() says, and so do sums and differences with floats and
+   * integers. Floats are saturated to the format when converted.
    */
   typedef class FixedPoint
   {
@@ -23,10 +169,10 @@ namespace espmath{
     uint8_t frac = FRACTIONAL;
 
     // Constructors
-    FixedPoint(){}
-    FixedPoint(float value, uint8_t fracBits = FRACTIONAL){frac = fracBits, data = toFixed(value, frac);}
-    FixedPoint(const FixedPoint& other):data(other.data),frac(other.frac){}
-    FixedPoint(const FixedPoint&& other):data(other.data),frac(other.frac){}
+    constexpr FixedPoint(){}
+    constexpr FixedPoint(float value, uint8_t fracBits = FRACTIONAL):data(toFixed(value, fracBits)),frac(fracBits){}
+    constexpr FixedPoint(const FixedPoint& other):data(other.data),frac(other.frac){}
+    constexpr FixedPoint(const FixedPoint&& other):data(other.data),frac(other.frac){}
 
     // Cast Operator
     operator float() const {return toFloat(data, frac);}
@@ -43,14 +189,23 @@ namespace espmath{
     bool operator!(){return !data;}
     
     // Arithmetic Operators
-    void operator+=(FixedPoint& other){assert(frac == other.frac); data += other.data;}
-    void operator+=(float other){data += FixedPoint(other);}
-    void operator-=(FixedPoint& other){assert(frac == other.frac); data -= other.data;}
-    void operator-=(float other){data -= FixedPoint(other);}
-    void operator*=(FixedPoint& other){assert(frac == other.frac); data = FP_MUL(data, other.data, frac);}
-    void operator*=(float other){data *= FixedPoint(other);}
-    void operator/=(FixedPoint& other){assert(frac == other.frac); data = FP_DIV(data, other.data, frac);}
-    void operator/=(float other){data /= FixedPoint(other);}
+    void operator+=(FixedPoint& other){assert(frac == other.frac); data = dsps_fixed_narrow_s16((int32_t)data + other.data, fixedArithmetic().mode());}
+    void operator+=(float other){data = dsps_fixed_narrow_s16((int32_t)data + toWide(other, frac), fixedArithmetic().mode());}
+    void operator-=(FixedPoint& other){assert(frac == other.frac); data = dsps_fixed_narrow_s16((int32_t)data - other.data, fixedArithmetic().mode());}
+    void operator-=(float other){data = dsps_fixed_narrow_s16((int32_t)data - toWide(other, frac), fixedArithmetic().mode());}
+    void operator*=(FixedPoint& other){assert(frac == other.frac); data = FP_MUL_MODE(data, other.data, frac, fixedArithmetic().mode());}
+    void operator*=(float other)
+    {
+      const int k = operandFrac(other, frac);
+      data = k < 0 ? toFixed(data*other, 0) : mulRound(data, toFixed(other, k), k);
+    }
+    void operator/=(FixedPoint& other){assert(frac == other.frac); data = FP_DIV_MODE(data, other.data, frac, fixedArithmetic().mode());}
+    void operator/=(float other)
+    {
+      const int k = operandFrac(other, frac);
+      const int16_t c = k < 0 ? 0 : toFixed(other, k);
+      data = c ? divRound(data, c, k) : toFixed(data/other, 0);
+    }
 
     static float toFloat(int16_t value, int frac)
     {
@@ -59,57 +214,436 @@ namespace espmath{
       return f;
     }
 
-    static int16_t toFixed(float value, int frac)
+    /**
+     * @brief float to Q(frac), rounded to nearest as dsps_f32_s16_esp does,
+     * saturated to 16 bits
+     */
+    static constexpr int16_t toFixed(float value, int frac)
     {
-      int16_t f = 0;
-      dsps_f32_s16_esp(&value, &f, frac);
-      return f;
+      return (int16_t)(toWide(value, frac) > INT16_MAX ? INT16_MAX : (toWide(value, frac) < INT16_MIN ? INT16_MIN : toWide(value, frac)));
+    }
+
+    /**
+     * @brief float to Q(frac) on 32 bits, rounded to nearest. Saturated to
+     * +-2^30, so that a sum with a 16 bits value does not overflow; NaN is 0.
+     */
+    static constexpr int32_t toWide(float value, int frac)
+    {
+      return value != value ? 0 : (value*(float)(1 << frac) >= 1073741824.f ? 1073741824 :\
+             (value*(float)(1 << frac) <= -1073741824.f ? -1073741824 : (int32_t)(value*(float)(1 << frac) + (value < 0 ? -0.5f : 0.5f))));
+    }
+
+    /**
+     * @brief True when value rounded to Q(frac) fits 16 bits
+     */
+    static constexpr bool fitsFixed(float value, int frac)
+    {
+      return value*(float)(1 << frac) < 32767.5f && value*(float)(1 << frac) > -32768.5f;
+    }
+
+    /**
+     * @brief Largest format, up to Q(frac), that holds value; -1 when not even Q0 does.
+     * A product or a quotient with value in Q(k) is shifted by k instead of frac.
+     */
+    static constexpr int operandFrac(float value, int frac)
+    {
+      return frac < 0 || fitsFixed(value, frac) ? frac : operandFrac(value, frac - 1);
+    }
+
+    /**
+     * @brief a*b of two Q(frac) values, rounded to nearest
+     */
+    static constexpr int16_t mulRound(int16_t a, int16_t b, int frac)
+    {
+      return (int16_t)(((int32_t)a*b + (frac ? (int32_t)1 << (frac - 1) : 0)) >> frac);
+    }
+
+    /**
+     * @brief a/b of two Q(frac) values, rounded to nearest (halves away from zero)
+     */
+    static constexpr int16_t divRound(int16_t a, int16_t b, int frac)
+    {
+      return (int16_t)(((a < 0) == (b < 0) ? (int32_t)a*(1 << frac) + b/2 : (int32_t)a*(1 << frac) - b/2)/b);
     }
   }fixed;
 
   /* Extended Comparison Operators*/
   bool operator>(FixedPoint& one, FixedPoint& another);
-  bool operator>(FixedPoint& one, float another);
-  bool operator>(float another, FixedPoint& one);
   bool operator>=(FixedPoint& one, FixedPoint& another);
-  bool operator>=(FixedPoint& one, float another);
-  bool operator>=(float another, FixedPoint& one);
   bool operator<(FixedPoint& one, FixedPoint& another);
-  bool operator<(FixedPoint& one, float another);
-  bool operator<(float another, FixedPoint& one);
   bool operator<=(FixedPoint& one, FixedPoint& another);
-  bool operator<=(FixedPoint& one, float another);
-  bool operator<=(float another, FixedPoint& one);
+  inline bool operator>(FixedPoint& one, float another){return one.data > FixedPoint::toFixed(another, one.frac);}
+  inline bool operator>(float another, FixedPoint& one){return FixedPoint::toFixed(another, one.frac) > one.data;}
+  inline bool operator>=(FixedPoint& one, float another){return one.data >= FixedPoint::toFixed(another, one.frac);}
+  inline bool operator>=(float another, FixedPoint& one){return FixedPoint::toFixed(another, one.frac) >= one.data;}
+  inline bool operator<(FixedPoint& one, float another){return one.data < FixedPoint::toFixed(another, one.frac);}
+  inline bool operator<(float another, FixedPoint& one){return FixedPoint::toFixed(another, one.frac) < one.data;}
+  inline bool operator<=(FixedPoint& one, float another){return one.data <= FixedPoint::toFixed(another, one.frac);}
+  inline bool operator<=(float another, FixedPoint& one){return FixedPoint::toFixed(another, one.frac) <= one.data;}
 
   /* Extended Arithmetic Operators*/
   fixed operator+(fixed f1, fixed f2);
   fixed operator-(fixed f1, fixed f2);
   fixed operator*(fixed f1, fixed f2);
   fixed operator/(fixed f1, fixed f2);
-  fixed operator+(fixed f1, float f);
-  fixed operator-(fixed f1, float f);
-  fixed operator*(fixed f1, float f);
-  fixed operator/(fixed f1, float f);
-  fixed operator+(float f, fixed f1);
-  fixed operator-(float f, fixed f1);
-  fixed operator*(float f, fixed f1);
-  fixed operator/(float f, fixed f1);
+
+  /* Mixed with floats: inline, so that constants are converted by the compiler */
+  inline fixed operator+(fixed f1, float f){f1 += f; return f1;}
+  inline fixed operator-(fixed f1, float f){f1 -= f; return f1;}
+  inline fixed operator*(fixed f1, float f){f1 *= f; return f1;}
+  inline fixed operator/(fixed f1, float f){f1 /= f; return f1;}
+  inline fixed operator+(float f, fixed f1){f1 += f; return f1;}
+  inline fixed operator-(float f, fixed f1){f1.data = dsps_fixed_narrow_s16(FixedPoint::toWide(f, f1.frac) - f1.data, fixedArithmetic().mode()); return f1;}
+  inline fixed operator*(float f, fixed f1){f1 *= f; return f1;}
+  inline fixed operator/(float f, fixed f1)
+  {
+    if (FixedPoint::fitsFixed(f, f1.frac))
+      f1.data = FixedPoint::divRound(FixedPoint::toFixed(f, f1.frac), f1.data, f1.frac);
+    else
+      f1.data = FixedPoint::toFixed(f/(float)f1, f1.frac);
+    return f1;
+  }
+
+  /* Mixed with other types: integers are exact, without conversion */
   template<typename T>
-  fixed operator+(fixed f1, T t){return f1 + (float)t;}
+  fixed operator+(fixed f1, T t)
+  {
+    if (!std::is_integral<T>::value) return f1 + (float)t;
+    f1.data = dsps_fixed_narrow64_s16(f1.data + (int64_t)t*((int64_t)1 << f1.frac), fixedArithmetic().mode());
+    return f1;
+  }
   template<typename T>
-  fixed operator-(fixed f1, T t){return f1 - (float)t;}
+  fixed operator-(fixed f1, T t)
+  {
+    if (!std::is_integral<T>::value) return f1 - (float)t;
+    f1.data = dsps_fixed_narrow64_s16(f1.data - (int64_t)t*((int64_t)1 << f1.frac), fixedArithmetic().mode());
+    return f1;
+  }
   template<typename T>
-  fixed operator*(fixed f1, T t){return f1 * (float)t;}
+  fixed operator*(fixed f1, T t)
+  {
+    if (!std::is_integral<T>::value) return f1 * (float)t;
+    f1.data = dsps_fixed_narrow64_s16(f1.data*(int64_t)t, fixedArithmetic().mode());
+    return f1;
+  }
   template<typename T>
-  fixed operator/(fixed f1, T t){return f1 / (float)t;}
+  fixed operator/(fixed f1, T t)
+  {
+    if (!std::is_integral<T>::value) return f1 / (float)t;
+    f1.data = t ? FixedPoint::divRound(f1.data, (int16_t)t, 0) : FP_DIV_ZERO(f1.data);
+    return f1;
+  }
   template<typename T>
-  fixed operator+(T t, fixed f1){return f1 + (float)t;}
+  fixed operator+(T t, fixed f1){return f1 + t;}
   template<typename T>
-  fixed operator-(T t, fixed f1){return (float)t - f1;}
+  fixed operator-(T t, fixed f1)
+  {
+    if (!std::is_integral<T>::value) return (float)t - f1;
+    f1.data = dsps_fixed_narrow64_s16((int64_t)t*((int64_t)1 << f1.frac) - f1.data, fixedArithmetic().mode());
+    return f1;
+  }
   template<typename T>
-  fixed operator*(T t, fixed f1){return (float)t * f1;}
+  fixed operator*(T t, fixed f1){return f1 * t;}
   template<typename T>
   fixed operator/(T t, fixed f1){return (float)t / f1;}
+
+  /**
+   * @brief Wider type holding the intermediate results of Fixed<FRAC, Storage>
+   */
+  template<typename Storage> struct FixedWide
+  {
+    typedef typename std::conditional<(sizeof(Storage) > 2), int64_t, int32_t>::type type;
+  };
+
+  /**
+   * @brief Wider type of two storages: int64_t whenever one of them is wider than 16 bits
+   */
+  template<typename S, typename T> struct FixedCommonWide
+  {
+    typedef typename FixedWide<typename std::conditional<(sizeof(S) > sizeof(T)), S, T>::type>::type type;
+  };
+
+  template<int FRAC, typename Storage = int16_t> class Fixed;
+
+  /**
+   * @brief Fixed point number whose format is known at compile time
+   *
+   * Q(FRAC) values take sizeof(Storage) bytes, 2 by default, with no frac
+   * stored next to them. Conversions from float are constexpr, so constants
+   * are converted by the compiler, and formats are checked at compile time.
+   *
+   * Operands of different formats are aligned by shifts worked out at
+   * compile time:
+   * - a + b, a - b and a / b have the format of a;
+   * - a * b is the exact product, Q(FRAC_a + FRAC_b) on the wider type;
+   * - a Fixed converts to any other format, rounding to nearest when it
+   * loses bits, e.g. Fixed<12> y = a*b.
+   *
+   * Sums and differences that do not fit the storage wrap around or
+   * saturate as fixedArithmetic().overflow says, as they do with FixedPoint;
+   * products and quotients wrap around. Conversions from float saturate. Products and quotients
+   * with a float take it in the finest format that holds it, as FixedPoint
+   * does, and go through float when none does. A zero divisor gives the
+   * largest value of the sign of the dividend.
+   *
+   * FixedPoint (fixed) remains the variant whose format is chosen at runtime.
+   *
+   * @tparam FRAC Fractional bits
+   * @tparam Storage Signed integer holding the value: int8_t, int16_t, int32_t or int64_t
+   */
+  template<int FRAC, typename Storage> class Fixed
+  {
+    static_assert(std::is_integral<Storage>::value && std::is_signed<Storage>::value, "Fixed needs a signed integer storage!");
+    static_assert(FRAC >= 0 && FRAC < 8*(int)sizeof(Storage), "FRAC does not fit the storage!");
+
+  public:
+    typedef Storage storage_t;
+    typedef typename FixedWide<Storage>::type wide_t;
+    static constexpr int frac = FRAC;
+
+    Storage data;
+
+    // Constructors
+    constexpr Fixed():data(0){}
+    constexpr Fixed(const float value):data(fromFloat(value)){}
+    template<int F, typename S>
+    constexpr Fixed(const Fixed<F, S>& other):data((Storage)rescale<F, FRAC>((typename FixedCommonWide<S, Storage>::type)other.data))
+    {
+      static_assert(F - FRAC < 8*(int)sizeof(typename FixedCommonWide<S, Storage>::type) &&\
+                    FRAC - F < 8*(int)sizeof(typename FixedCommonWide<S, Storage>::type), "The shift does not fit the wide type!");
+    }
+
+    /**
+     * @brief Fixed point value from its raw Q(FRAC) integer
+     */
+    static constexpr Fixed raw(const Storage value){return Fixed(value, 0);}
+
+    // Cast Operators
+    constexpr float toFloat() const {return (float)data*(1.f/(float)((int64_t)1 << FRAC));}
+    explicit constexpr operator float() const {return toFloat();}
+
+    // Arithmetic Operators
+    constexpr Fixed operator-() const {return raw((Storage)-data);}
+    template<int F, typename S> Fixed& operator+=(const Fixed<F, S>& other){data = narrow((wide_t)data + Fixed(other).data); return *this;}
+    template<int F, typename S> Fixed& operator-=(const Fixed<F, S>& other){data = narrow((wide_t)data - Fixed(other).data); return *this;}
+    template<int F, typename S> Fixed& operator*=(const Fixed<F, S>& other){return *this = Fixed(*this * other);}
+    template<int F, typename S> Fixed& operator/=(const Fixed<F, S>& other){return *this = *this / other;}
+    Fixed& operator+=(const float other){return *this += Fixed(other);}
+    Fixed& operator-=(const float other){return *this -= Fixed(other);}
+    Fixed& operator*=(const float other){data = mulFloat(data, other); return *this;}
+    Fixed& operator/=(const float other){data = divFloat(data, other); return *this;}
+
+    /**
+     * @brief Q(FROM) value to Q(TO), rounding to nearest when bits are dropped
+     */
+    template<int FROM, int TO, typename W>
+    static constexpr W rescale(const W value)
+    {
+      return TO >= FROM ? value*((W)1 << (TO >= FROM ? TO - FROM : 0)) :\
+             (value + ((W)1 << (TO < FROM ? FROM - TO - 1 : 0))) >> (TO < FROM ? FROM - TO : 0);
+    }
+
+    /**
+     * @brief float to Q(FRAC), rounded to nearest and saturated. 8 and 16
+     * bits formats are scaled in float, so that runtime conversions do not
+     * go through soft double arithmetic.
+     */
+    static constexpr Storage fromFloat(const float value)
+    {
+      return sizeof(Storage) <= 2 ? saturate<float>(value*(float)((int64_t)1 << FRAC)) :\
+                                    saturate<double>((double)value*((int64_t)1 << FRAC));
+    }
+
+    /**
+     * @brief A sum or a difference back to the storage, wrapped or saturated
+     * as fixedArithmetic().overflow says
+     */
+    static Storage narrow(const wide_t value)
+    {
+      return fixedArithmetic().overflow == FIXED_SATURATE ?\
+             (value > std::numeric_limits<Storage>::max() ? std::numeric_limits<Storage>::max() :\
+             (value < std::numeric_limits<Storage>::lowest() ? std::numeric_limits<Storage>::lowest() : (Storage)value)) :\
+             (Storage)(typename std::make_unsigned<wide_t>::type)value;
+    }
+
+    /**
+     * @brief Largest format, up to Q(frac), that holds value in the storage;
+     * -1 when not even Q0 does (always for 64 bits storages, whose products
+     * do not fit the wide type). A product or a quotient with value in Q(k)
+     * is shifted by k instead of FRAC.
+     */
+    static constexpr int operandFrac(const float value, const int frac)
+    {
+      return sizeof(Storage) > 4 ? -1 : (frac < 0 ||\
+             (value*(float)((int64_t)1 << frac) < (float)std::numeric_limits<Storage>::max() &&\
+              value*(float)((int64_t)1 << frac) > (float)std::numeric_limits<Storage>::lowest()) ? frac : operandFrac(value, frac - 1));
+    }
+
+    /**
+     * @brief data*value of a Q(FRAC) data, rounded to nearest
+     */
+    static constexpr Storage mulFloat(const Storage data, const float value)
+    {
+      return mulFloat(data, value, operandFrac(value, FRAC));
+    }
+
+    /**
+     * @brief data/value of a Q(FRAC) data, truncated as Fixed / Fixed
+     */
+    static constexpr Storage divFloat(const Storage data, const float value)
+    {
+      return divFloat(data, value, operandFrac(value, FRAC));
+    }
+
+    /**
+     * @brief value/data of a Q(FRAC) data, truncated as Fixed / Fixed
+     */
+    static constexpr Storage floatDiv(const float value, const Storage data)
+    {
+      return operandFrac(value, FRAC) == FRAC ? quotient(fromFloat(value), data, FRAC) :\
+             scaled(value/((float)data*(1.f/(float)((int64_t)1 << FRAC)))*(float)((int64_t)1 << FRAC));
+    }
+
+  private:
+    constexpr Fixed(const Storage value, int):data(value){}
+
+    /**
+     * @brief (n << shift)/d truncated, the largest value of the sign of n when d is 0
+     */
+    static constexpr Storage quotient(const Storage n, const Storage d, const int shift)
+    {
+      return d ? (Storage)((wide_t)n*((wide_t)1 << shift)/d) :\
+             (n > 0 ? std::numeric_limits<Storage>::max() : (n < 0 ? std::numeric_limits<Storage>::lowest() : 0));
+    }
+
+    /**
+     * @brief value in Q(k), rounded to nearest
+     */
+    static constexpr wide_t operand(const float value, const int k)
+    {
+      return (wide_t)(value*(float)((int64_t)1 << k) + (value < 0 ? -0.5f : 0.5f));
+    }
+
+    /**
+     * @brief value, already in Q(FRAC), rounded and saturated to the storage
+     */
+    static constexpr Storage scaled(const float value)
+    {
+      return sizeof(Storage) <= 2 ? saturate<float>(value) : saturate<double>((double)value);
+    }
+
+    static constexpr Storage mulFloat(const Storage data, const float value, const int k)
+    {
+      return k < 0 ? (sizeof(Storage) <= 2 ? saturate<float>((float)data*value) : saturate<double>((double)data*value)) :\
+             (Storage)(((wide_t)data*operand(value, k) + (k ? (wide_t)1 << (k ? k - 1 : 0) : 0)) >> k);
+    }
+
+    static constexpr Storage divFloat(const Storage data, const float value, const int k)
+    {
+      return k < 0 || !operand(value, k) ? (sizeof(Storage) <= 2 ? saturate<float>((float)data/value) : saturate<double>((double)data/value)) :\
+             (Storage)((wide_t)data*((wide_t)1 << k)/operand(value, k));
+    }
+
+    template<typename F>
+    static constexpr Storage saturate(const F scaled)
+    {
+      return scaled != scaled ? 0 : scaled >= (F)std::numeric_limits<Storage>::max() ? std::numeric_limits<Storage>::max() :\
+             (scaled <= (F)std::numeric_limits<Storage>::lowest() ? std::numeric_limits<Storage>::lowest() :\
+             (Storage)(scaled + (scaled < 0 ? (F)-0.5 : (F)0.5)));
+    }
+  };
+
+  static_assert(sizeof(Fixed<15>) == 2, "Fixed<FRAC> must keep the size of its storage!");
+
+  /**
+   * @brief 32 bits formats: products and quotients go through 64 bits
+   */
+  typedef Fixed<16, int32_t> q16_16;
+  typedef Fixed<31, int32_t> q31;
+
+  /* The format of the left operand, wrapped or saturated as fixedArithmetic() says */
+  template<int F, typename S, int G, typename T>
+  inline Fixed<F, S> operator+(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    return Fixed<F, S>::raw(Fixed<F, S>::narrow((typename Fixed<F, S>::wide_t)a.data + Fixed<F, S>(b).data));
+  }
+
+  template<int F, typename S, int G, typename T>
+  inline Fixed<F, S> operator-(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    return Fixed<F, S>::raw(Fixed<F, S>::narrow((typename Fixed<F, S>::wide_t)a.data - Fixed<F, S>(b).data));
+  }
+
+  /* Exact product: Q(F + G) on the wider type */
+  template<int F, typename S, int G, typename T>
+  constexpr Fixed<F + G, typename FixedWide<typename std::conditional<(sizeof(S) > sizeof(T)), S, T>::type>::type>\
+  operator*(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    typedef typename FixedWide<typename std::conditional<(sizeof(S) > sizeof(T)), S, T>::type>::type W;
+    return Fixed<F + G, W>::raw((W)a.data*b.data);
+  }
+
+  /* (a << G)/b keeps the format of a, truncated as FP_DIV does; a zero divisor gives the largest value of the sign of a */
+  template<int F, typename S, int G, typename T>
+  constexpr Fixed<F, S> operator/(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    typedef typename FixedWide<typename std::conditional<(sizeof(S) > sizeof(T)), S, T>::type>::type W;
+    return Fixed<F, S>::raw(b.data ? (S)((W)a.data*((W)1 << G)/b.data) :\
+                            (a.data > 0 ? std::numeric_limits<S>::max() : (a.data < 0 ? std::numeric_limits<S>::lowest() : 0)));
+  }
+
+  /* float operands take the format of the Fixed one; products and quotients the finest format that holds them */
+  template<int F, typename S> inline Fixed<F, S> operator+(const Fixed<F, S>& a, const float b){return a + Fixed<F, S>(b);}
+  template<int F, typename S> inline Fixed<F, S> operator-(const Fixed<F, S>& a, const float b){return a - Fixed<F, S>(b);}
+  template<int F, typename S> constexpr Fixed<F, S> operator*(const Fixed<F, S>& a, const float b){return Fixed<F, S>::raw(Fixed<F, S>::mulFloat(a.data, b));}
+  template<int F, typename S> constexpr Fixed<F, S> operator/(const Fixed<F, S>& a, const float b){return Fixed<F, S>::raw(Fixed<F, S>::divFloat(a.data, b));}
+  template<int F, typename S> inline Fixed<F, S> operator+(const float a, const Fixed<F, S>& b){return Fixed<F, S>(a) + b;}
+  template<int F, typename S> inline Fixed<F, S> operator-(const float a, const Fixed<F, S>& b){return Fixed<F, S>(a) - b;}
+  template<int F, typename S> constexpr Fixed<F, S> operator*(const float a, const Fixed<F, S>& b){return Fixed<F, S>::raw(Fixed<F, S>::mulFloat(b.data, a));}
+  template<int F, typename S> constexpr Fixed<F, S> operator/(const float a, const Fixed<F, S>& b){return Fixed<F, S>::raw(Fixed<F, S>::floatDiv(a, b.data));}
+
+  /**
+   * @brief a and b in the finer of their formats, on the wider type
+   */
+  template<int F, typename S, int G, typename T>
+  struct FixedAligned
+  {
+    typedef typename FixedCommonWide<S, T>::type W;
+    static constexpr int M = F > G ? F : G;
+    static constexpr W left(const Fixed<F, S>& a){return Fixed<M, W>(a).data;}
+    static constexpr W right(const Fixed<G, T>& b){return Fixed<M, W>(b).data;}
+  };
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator==(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    return FixedAligned<F, S, G, T>::left(a) == FixedAligned<F, S, G, T>::right(b);
+  }
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator!=(const Fixed<F, S>& a, const Fixed<G, T>& b){return !(a == b);}
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator<(const Fixed<F, S>& a, const Fixed<G, T>& b)
+  {
+    return FixedAligned<F, S, G, T>::left(a) < FixedAligned<F, S, G, T>::right(b);
+  }
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator>(const Fixed<F, S>& a, const Fixed<G, T>& b){return b < a;}
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator<=(const Fixed<F, S>& a, const Fixed<G, T>& b){return !(b < a);}
+
+  template<int F, typename S, int G, typename T>
+  constexpr bool operator>=(const Fixed<F, S>& a, const Fixed<G, T>& b){return !(a < b);}
+
+  template<int F, typename S> constexpr bool operator==(const Fixed<F, S>& a, const float b){return a == Fixed<F, S>(b);}
+  template<int F, typename S> constexpr bool operator!=(const Fixed<F, S>& a, const float b){return a != Fixed<F, S>(b);}
+  template<int F, typename S> constexpr bool operator<(const Fixed<F, S>& a, const float b){return a < Fixed<F, S>(b);}
+  template<int F, typename S> constexpr bool operator>(const Fixed<F, S>& a, const float b){return a > Fixed<F, S>(b);}
+  template<int F, typename S> constexpr bool operator<=(const Fixed<F, S>& a, const float b){return a <= Fixed<F, S>(b);}
+  template<int F, typename S> constexpr bool operator>=(const Fixed<F, S>& a, const float b){return a >= Fixed<F, S>(b);}
 }
 
 #endif
\ No newline at end of file
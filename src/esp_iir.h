@@ -0,0 +1,148 @@
+#ifndef _ESP_IIR_H_
+#define _ESP_IIR_H_
+
+#include "esp_platform.h"
+#include "esp_array.h"
+
+namespace espmath{
+  /**
+   * @brief Cascade of second order sections (biquads), with interleaved channels
+   *
+   * Each section is a row {b0, b1, b2, a1, a2} of
+   * H(z) = (b0 + b1*z^-1 + b2*z^-2)/(1 + a1*z^-1 + a2*z^-2)
+   * and the sections are applied one after the other.
+   *
+   * The state of every channel is kept between calls, so a continuous stream
+   * is processed in blocks of any size, in place, without allocating. The
+   * channels are interleaved: a block of frames is a (frames, channels) array
+   * whose column c is channel c, the same stride convention as Array::column.
+   *
+   * For int16_t filters (Q15 or any other fixed point format), the frac of
+   * the coefficients is the post-shift: the products of a section are
+   * accumulated on 40 bits, shifted right by it once and saturated, so the
+   * output keeps the format of the input. Since a1 is often out of [-1, 1),
+   * Q14 coefficients are the usual choice.
+   *
+   * @note float and int16_t filters make use of DSP instructions.
+   *
+   * @tparam T Filter type
+   */
+  template<typename T = float> class Iir
+  {
+  public:
+    /**
+     * @brief Construct a new Iir object with a zeroed state
+     *
+     * @param sections One row {b0, b1, b2, a1, a2} per section, a0 being 1.
+     * @param channels Number of interleaved channels, each with its own state.
+     */
+    Iir(const Array<T>& sections, const size_t channels = 1):
+      _coeffs(sections),
+      _state(shape2D(channels, 4*sections.shape.rows)),
+      _channels(channels)
+    {
+      ESP_ERROR_CHECK(sections.shape.columns != 5); //"a section is {b0, b1, b2, a1, a2}!"
+      ESP_ERROR_CHECK(channels == 0);
+      reset();
+    }
+
+    /**
+     * @brief Filter a block of interleaved frames
+     *
+     * @param input frames*channels samples, frame after frame
+     * @param output frames*channels samples. It may be the input buffer.
+     * @param frames Number of frames
+     */
+    void process(const T* input, T* output, const size_t frames)
+    {
+      for (size_t c = 0; c < _channels; c++)
+        filter(input + c, output + c, frames, c, _channels);
+    }
+
+    /**
+     * @brief Filter a block of interleaved frames in place
+     *
+     * @param block (frames, channels) array, or any array holding whole frames
+     */
+    void process(Array<T>& block)
+    {
+      assert(block.shape.size % _channels == 0);
+      process(block.flatten, block.flatten, block.shape.size/_channels);
+    }
+
+    /**
+     * @brief Filter one channel in place, through a strided view
+     *
+     * e.g. iir.process(block.column(1), 1) filters the second channel only.
+     *
+     * @param view Samples of the channel
+     * @param channel Channel whose state is used
+     */
+    void process(const ArrayView<T>& view, const size_t channel = 0)
+    {
+      assert(channel < _channels);
+      filter(view.data(), view.data(), view.length(), channel, view.stride());
+    }
+
+    /**
+     * @brief Clear the state of every channel, as if the filter had only seen zeros
+     */
+    void reset()
+    {
+      if (_state.flatten)
+        memset(_state.flatten, 0, _state.shape.size*sizeof(T));
+    }
+
+    size_t sections() const {return _coeffs.shape.rows;}
+    size_t channels() const {return _channels;}
+
+  private:
+    Array<T> _coeffs; /* One section per row */
+    Array<T> _state;  /* One channel per row, 4 values per section (float kernels use 2) */
+    size_t _channels;
+
+    /**
+     * @brief Run the cascade over len samples, step elements apart (direct form I)
+     */
+    void filter(const T* x, T* y, const size_t len, const size_t channel, const size_t step)
+    {
+      typedef typename ArrayStats<T>::sum_t sum_t;
+      const T* coef = _coeffs.flatten;
+      T* state = _state.flatten + channel*_state.shape.columns;
+      for (size_t s = 0; s < _coeffs.shape.rows; s++, coef += 5, state += 4, x = y)
+      {
+        for (size_t i = 0; i < len; i++)
+        {
+          const T in = x[i*step];
+          const sum_t acc = (sum_t)coef[0]*in + (sum_t)coef[1]*state[0] + (sum_t)coef[2]*state[1]\
+                            - (sum_t)coef[3]*state[2] - (sum_t)coef[4]*state[3];
+          state[1] = state[0];
+          state[0] = in;
+          state[3] = state[2];
+          state[2] = (T)(acc/((int64_t)1 << _coeffs.frac));
+          y[i*step] = state[2];
+        }
+      }
+    }
+  };
+
+#if ESP_MATH_DSP
+
+  template<>
+  inline void Iir<float>::filter(const float* x, float* y, const size_t len, const size_t channel, const size_t step)
+  {
+    exec_dsp(dsps_biquad_f32_esp, x, y, len, _coeffs, _state.flatten + channel*_state.shape.columns,\
+             _coeffs.shape.rows, step);
+  }
+
+  template<>
+  inline void Iir<int16_t>::filter(const int16_t* x, int16_t* y, const size_t len, const size_t channel, const size_t step)
+  {
+    exec_dsp(dsps_biquad_s16_esp, x, y, len, _coeffs, _state.flatten + channel*_state.shape.columns,\
+             _coeffs.shape.rows, step, _coeffs.frac);
+  }
+
+#endif
+}
+
+#endif
@@ -2,9 +2,13 @@
 #define _ESP_MATH_H_
 
 #include "esp_array.h"
+#include "esp_fir.h"
+#include "esp_iir.h"
+#include "esp_fft.h"
 #include "esp_rng.h"
 #include "esp_opt.h"
 #include "esp_dsp.h"
+#include "esp_parallel.h"
 #include "esp_ansi.h"
 #include "esp_fixed_point.h"
 
@@ -1,7 +1,9 @@
 #ifndef _ESP_MATH_OPT_H_
 #define _ESP_MATH_OPT_H_  
 
+#ifdef ESP_PLATFORM
 #include "esp_idf_version.h"
+#endif
 
 /**
  * @brief Memory Alignment
@@ -15,10 +17,7 @@
  */
 #define FRACTIONAL 8
 
-/*Uncomment to enable benchmark results via uart port.*/
-//#define BENCHMARK_TEST
-
-
+#ifdef ESP_PLATFORM
 #if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #define dsp_ENTER_CRITICAL      portSET_INTERRUPT_MASK_FROM_ISR
 #define dsp_EXIT_CRITICAL       portCLEAR_INTERRUPT_MASK_FROM_ISR
@@ -26,5 +25,10 @@
 #define dsp_ENTER_CRITICAL      portENTER_CRITICAL_NESTED
 #define dsp_EXIT_CRITICAL       portEXIT_CRITICAL_NESTED
 #endif
+#else
+/* Host build: mocked in esp_platform.h */
+#define dsp_ENTER_CRITICAL      portSET_INTERRUPT_MASK_FROM_ISR
+#define dsp_EXIT_CRITICAL       portCLEAR_INTERRUPT_MASK_FROM_ISR
+#endif
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,148 @@
+#include "esp_parallel.h"
+
+#if ESP_MATH_HOST
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace espmath{
+  namespace parallel{
+#if ESP_MATH_HOST
+
+    struct Worker
+    {
+      void (*job)(void*) = NULL;
+      void* arg = NULL;
+      std::atomic<bool> busy{false};
+      bool pending = false;
+      bool done = false;
+      std::mutex mutex;
+      std::condition_variable wake;
+    };
+
+    static void workerLoop(Worker* w)
+    {
+      std::unique_lock<std::mutex> lock(w->mutex);
+      for (;;)
+      {
+        w->wake.wait(lock, [w]{return w->pending;});
+        w->pending = false;
+        lock.unlock();
+        w->job(w->arg);
+        lock.lock();
+        w->done = true;
+        w->wake.notify_all();
+      }
+    }
+
+    /**
+     * @brief The worker, started on first use. It is never destroyed: its
+     * thread waits on it until the program ends.
+     */
+    static Worker& worker()
+    {
+      static Worker* w = NULL;
+      static std::once_flag started;
+      std::call_once(started, []{
+        w = new Worker();
+        std::thread(workerLoop, w).detach();
+      });
+      return *w;
+    }
+
+    int launch(void (*job)(void*), void* arg)
+    {
+      Worker& w = worker();
+      bool idle = false;
+      /* Blocking with the (mocked) interrupts masked would hang on the device */
+      if (hostInterruptLevel() || !w.busy.compare_exchange_strong(idle, true))
+        return -1;
+      std::lock_guard<std::mutex> lock(w.mutex);
+      w.job = job;
+      w.arg = arg;
+      w.done = false;
+      w.pending = true;
+      w.wake.notify_all();
+      return 0;
+    }
+
+    void wait(const int)
+    {
+      Worker& w = worker();
+      {
+        std::unique_lock<std::mutex> lock(w.mutex);
+        w.wake.wait(lock, [&w]{return w.done;});
+      }
+      w.busy = false;
+    }
+
+#else
+
+    struct Worker
+    {
+      void (*job)(void*);
+      void* arg;
+      TaskHandle_t task;
+      SemaphoreHandle_t busy;
+      SemaphoreHandle_t done;
+    };
+
+    static void workerLoop(void* param)
+    {
+      Worker* w = (Worker*)param;
+      for (;;)
+      {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        w->job(w->arg);
+        xSemaphoreGive(w->done);
+      }
+    }
+
+    /**
+     * @brief One worker per core, started on first use
+     */
+    static Worker* workers()
+    {
+      static Worker* w = []{
+        Worker* created = (Worker*)calloc(portNUM_PROCESSORS, sizeof(Worker));
+        for (int core = 0; created && core < portNUM_PROCESSORS; core++)
+        {
+          created[core].busy = xSemaphoreCreateBinary();
+          created[core].done = xSemaphoreCreateBinary();
+          xSemaphoreGive(created[core].busy);
+          xTaskCreatePinnedToCore(workerLoop, "espmath", ESP_MATH_PARALLEL_STACK, created + core,\
+                                  tskIDLE_PRIORITY + 1, &created[core].task, core);
+        }
+        return created;
+      }();
+      return w;
+    }
+
+    int launch(void (*job)(void*), void* arg)
+    {
+      if (portNUM_PROCESSORS < 2 || !xPortCanYield())
+        return -1;
+      Worker* all = workers();
+      const int core = xPortGetCoreID() ? 0 : 1;
+      if (!all || !all[core].task || xSemaphoreTake(all[core].busy, 0) != pdTRUE)
+        return -1;
+      Worker& w = all[core];
+      w.job = job;
+      w.arg = arg;
+      vTaskPrioritySet(w.task, uxTaskPriorityGet(NULL));
+      xTaskNotifyGive(w.task);
+      return core;
+    }
+
+    void wait(const int worker)
+    {
+      Worker& w = workers()[worker];
+      xSemaphoreTake(w.done, portMAX_DELAY);
+      xSemaphoreGive(w.busy);
+    }
+
+#endif
+  }
+}
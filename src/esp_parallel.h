@@ -0,0 +1,122 @@
+#ifndef _ESP_PARALLEL_H_
+#define _ESP_PARALLEL_H_
+
+#include "esp_platform.h"
+
+/**
+ * @brief Whether long operations are split across both cores by default
+ */
+#ifndef ESP_MATH_PARALLEL
+#define ESP_MATH_PARALLEL 0
+#endif
+
+/**
+ * @brief Default size below which operations stay on the calling core: elements
+ * for element-wise operations and reductions, multiply-accumulates for
+ * convolutions, correlations and matrix products
+ */
+#ifndef ESP_MATH_PARALLEL_THRESHOLD
+#define ESP_MATH_PARALLEL_THRESHOLD 16384
+#endif
+
+/**
+ * @brief Stack of the worker tasks, in bytes (ESP32 devices)
+ */
+#ifndef ESP_MATH_PARALLEL_STACK
+#define ESP_MATH_PARALLEL_STACK 4096
+#endif
+
+namespace espmath{
+  /**
+   * @brief Parallel execution settings, changeable at runtime
+   */
+  struct ParallelConfig
+  {
+    bool enabled;     /* split long operations across both cores */
+    size_t threshold; /* smaller operations stay on the calling core */
+  };
+
+  /**
+   * @brief Parallel execution settings, set with ESP_MATH_PARALLEL and
+   * ESP_MATH_PARALLEL_THRESHOLD
+   *
+   * @return ParallelConfig&
+   */
+  inline ParallelConfig& parallelism()
+  {
+    static ParallelConfig config = {ESP_MATH_PARALLEL != 0, ESP_MATH_PARALLEL_THRESHOLD};
+    return config;
+  }
+
+  /**
+   * @brief Worker of the other core
+   *
+   * On ESP32 devices there is one FreeRTOS task pinned to each core, created
+   * the first time it is needed; a job started from a core runs on the
+   * worker of the other one, with the priority of the caller. On host the
+   * worker is a std::thread.
+   */
+  namespace parallel{
+    /**
+     * @brief Start job(arg) on the other core
+     *
+     * @return int Handle to wait for, or -1 when the worker is busy (or the
+     * caller cannot block): the caller then runs the job itself.
+     */
+    int launch(void (*job)(void*), void* arg);
+
+    /**
+     * @brief Wait for the job started by launch
+     *
+     * @param worker Handle returned by launch
+     */
+    void wait(const int worker);
+
+    template<typename Job> struct Half
+    {
+      Job* job;
+      size_t count;
+    };
+
+    template<typename Job> void runHalf(void* arg)
+    {
+      Half<Job>* half = (Half<Job>*)arg;
+      (*half->job)(0, half->count, 0);
+    }
+  }
+
+  /**
+   * @brief Split [0..len) in two parts, one per core
+   *
+   * job(begin, count, part) runs [0..split) as part 0 on the other core and
+   * [split..len) as part 1 on the calling core, split being a multiple of
+   * granule. Nothing runs when parallel execution is disabled, the work is
+   * under the threshold or the other core is busy: the caller then runs the
+   * whole operation itself.
+   *
+   * @param len Number of items (elements, rows, outputs)
+   * @param work Size compared to the threshold
+   * @param granule Items per part are a multiple of it
+   * @param job Callable job(begin, count, part)
+   * @return true when the job ran on both cores
+   */
+  template<typename Job>
+  inline bool parallelSplit(const size_t len, const size_t work, const size_t granule, Job& job)
+  {
+    const ParallelConfig& config = parallelism();
+    if (!config.enabled || work < config.threshold)
+      return false;
+    const size_t split = len/2 - (len/2) % granule;
+    if (split == 0)
+      return false;
+    parallel::Half<Job> half = {&job, split};
+    const int worker = parallel::launch(&parallel::runHalf<Job>, &half);
+    if (worker < 0)
+      return false;
+    job(split, len - split, 1);
+    parallel::wait(worker);
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef _ESP_MATH_PLATFORM_H_
+#define _ESP_MATH_PLATFORM_H_
+
+/**
+ * @brief Thin platform layer
+ *
+ * On ESP32 devices it pulls in the SDK. On any other machine (host build)
+ * it provides the handful of SDK symbols the library relies on:
+ * aligned allocation, the interrupt mask used by exec_dsp and a cycle counter.
+ *
+ * ESP_MATH_HOST is 1 on a host build and 0 on ESP32 devices.
+ * ESP_MATH_DSP is 1 whenever the dsps_* kernels are available, that is,
+ * on ESP32-S3 devices (PIE assembly) and on host builds (portable C++).
+ */
+
+#ifdef ESP_PLATFORM
+
+#include <Arduino.h>
+#include <sdkconfig.h>
+#include <esp_err.h>
+#include <esp_heap_caps.h>
+#include "dsp_err.h"
+
+#define ESP_MATH_HOST 0
+
+#if defined CONFIG_IDF_TARGET_ESP32S3 && CONFIG_IDF_TARGET_ESP32S3
+#define ESP_MATH_DSP 1
+#else
+#define ESP_MATH_DSP 0
+#endif
+
+/**
+ * @brief Get the current CPU cycle count
+ *
+ * @return uint32_t
+ */
+inline uint32_t dsp_get_ccount(){return xthal_get_ccount();}
+
+#else
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define ESP_MATH_HOST 1
+#define ESP_MATH_DSP 1
+
+typedef int esp_err_t;
+
+#define ESP_OK    0
+#define ESP_FAIL -1
+
+#define ESP_ERR_DSP_BASE                0x70000
+#define ESP_ERR_DSP_INVALID_LENGTH      (ESP_ERR_DSP_BASE + 1)
+#define ESP_ERR_DSP_INVALID_PARAM       (ESP_ERR_DSP_BASE + 2)
+#define ESP_ERR_DSP_PARAM_OUTOFRANGE    (ESP_ERR_DSP_BASE + 3)
+#define ESP_ERR_DSP_UNINITIALIZED       (ESP_ERR_DSP_BASE + 4)
+#define ESP_ERR_DSP_REINITIALIZED       (ESP_ERR_DSP_BASE + 5)
+#define ESP_ERR_DSP_ARRAY_NOT_ALIGNED   (ESP_ERR_DSP_BASE + 6)
+
+#define ESP_ERROR_CHECK(x) do {\
+  esp_err_t err_rc_ = (x);\
+  if (err_rc_ != ESP_OK) abort();\
+} while(0)
+
+#define MALLOC_CAP_32BIT (1<<1)
+#define MALLOC_CAP_8BIT  (1<<2)
+
+/**
+ * @brief Aligned allocation. Capabilities are ignored on host.
+ *
+ * @param alignment Alignment in bytes. Must be a power of two.
+ * @param size Bytes to allocate.
+ * @param caps Memory capabilities.
+ * @return void*
+ */
+inline void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps)
+{
+  (void)caps;
+  void* ptr = NULL;
+  if (posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, size))
+    return NULL;
+  return ptr;
+}
+
+inline void heap_caps_free(void* ptr){free(ptr);}
+
+/**
+ * @brief Mocked interrupt level.
+ *
+ * There are no interrupts on host, but keeping track of the mask lets
+ * exec_dsp (and anything built on top of it) be exercised as on the device.
+ * As the mask of a core, it belongs to the thread.
+ *
+ * @return unsigned&
+ */
+inline unsigned& hostInterruptLevel()
+{
+  static thread_local unsigned level = 0;
+  return level;
+}
+
+inline unsigned portSET_INTERRUPT_MASK_FROM_ISR()
+{
+  unsigned previous = hostInterruptLevel();
+  hostInterruptLevel() = 1;
+  return previous;
+}
+
+inline void portCLEAR_INTERRUPT_MASK_FROM_ISR(unsigned previous)
+{
+  hostInterruptLevel() = previous;
+}
+
+/**
+ * @brief Get the current CPU cycle count
+ *
+ * Uses the time stamp counter on x86 and the virtual counter on aarch64.
+ * Any other machine falls back to a nanosecond clock.
+ *
+ * @return uint32_t
+ */
+inline uint32_t dsp_get_ccount()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return (uint32_t)__rdtsc();
+#elif defined(__aarch64__)
+  uint64_t count;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(count));
+  return (uint32_t)count;
+#else
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Pseudo random number generator (xorshift32) standing in for the RF based one.
+ *
+ * @return uint32_t
+ */
+inline uint32_t esp_random()
+{
+  static uint32_t state = 2463534242u;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+#endif
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef _ESP_RANDOM_H_
 #define _ESP_RANDOM_H_
 
-#include <Arduino.h>
+#include "esp_platform.h"
 
 /**
  * @brief Generate a non-zero random number
@@ -20,7 +20,7 @@ inline T nonZeroRandomNumber(size_t _MAX_NUM_)
     rn = (T)esp_random() % _MAX_NUM_;
   }while(!rn);
 
-  if (rn > _MAX_NUM_ / 2) rn*=-1;
+  if (rn > (T)(_MAX_NUM_ / 2)) rn*=-1;
   return rn;
 }
 